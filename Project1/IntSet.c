@@ -10,43 +10,107 @@
  * Created: Fri Jul  1 09:51:18 2016
  * Time-stamp: <Wed Sep  7 17:58:37 EDT 2016 ferguson>
  *
- * Implementation of Set of ints as a simple linked list.
- * Adding to the set means adding at the front since that's cheapest.
- * Lookup (and hence add) is linear-time. You could do much better...
+ * Implementation of Set of ints as a bitset over the non-negative ints.
+ * Members live in an array of 64-bit words that grows on demand, so
+ * add/contains are constant-time and union/equals work a word at a time.
+ * Use IntSet_new_with_capacity() when the universe is known (e.g. the
+ * number of states of an automaton) to avoid regrowing.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 #include "IntSet.h"
 
+#define WORD_BITS 64
+
 /**
  * Toplevel structure for an IntSet.
- * This implementation simply uses a linked list.
+ * Bit i of words[i/64] is set iff i is a member.
  */
 struct IntSet {
-    struct IntSetNode *first;
-    struct IntSetNode *last;
+    uint64_t *words;
+    int nwords;
 };
 
 struct IntSetIterator {
-    struct IntSetNode *node;
+    const IntSet *set;
+    int next; // next member to return, or -1 when done
 };
 
 /**
- * Structure for each element in an IntSet, stored as a linked list.
+ * Return the number of one bits in the given word.
+ */
+static int
+popcount64(uint64_t word) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    while (word != 0) {
+        word &= word - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/**
+ * Return the index of the lowest one bit in the given (nonzero) word.
+ */
+static int
+lowest_bit64(uint64_t word) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int index = 0;
+    while ((word & 1) == 0) {
+        word >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+/**
+ * Make sure the given IntSet has room for at least nwords words.
  */
-typedef struct IntSetNode {
-    int value;
-    struct IntSetNode *next;
-} IntSetNode;
+static void
+IntSet_grow(IntSet *set, int nwords) {
+    if (nwords <= set->nwords) {
+        return;
+    }
+    uint64_t *words = (uint64_t*)realloc(set->words, nwords*sizeof(uint64_t));
+    if (words == NULL) {
+        abort();
+    }
+    memset(words + set->nwords, 0, (nwords - set->nwords)*sizeof(uint64_t));
+    set->words = words;
+    set->nwords = nwords;
+}
 
 /**
  * Allocate, initialize and return a new (empty) IntSet.
  */
 IntSet *
 IntSet_new() {
+    return IntSet_new_with_capacity(WORD_BITS);
+}
+
+/**
+ * Allocate, initialize and return a new (empty) IntSet sized for members
+ * in the range 0..n-1.
+ */
+IntSet *
+IntSet_new_with_capacity(int n) {
     IntSet *set = (IntSet*)malloc(sizeof(IntSet));
-    set->first = set->last = NULL;
+    if (set == NULL) {
+        abort();
+    }
+    set->words = NULL;
+    set->nwords = 0;
+    IntSet_grow(set, n > 0 ? (n + WORD_BITS - 1) / WORD_BITS : 1);
     return set;
 }
 
@@ -55,50 +119,58 @@ IntSet_new() {
  */
 void
 IntSet_free(IntSet *set) {
-    // Free the elements
-    IntSetNode *elt = set->first;
-    while (elt != NULL) {
-        IntSetNode *next = elt->next;
-        free(elt);
-        elt = next;
-    }
-    // Free the set (list)
+    free(set->words);
     free(set);
 }
 
 /**
- * Allocate and initialize a new IntSetNode storing the given int value.
+ * Return true if the given IntSet is empty.
  */
-static IntSetNode *
-IntSetNode_new(int value) {
-    IntSetNode *node = (IntSetNode*)malloc(sizeof(IntSetNode));
-    if (node == NULL) {
-        abort();
+bool
+IntSet_is_empty(const IntSet *set) {
+    for (int i = 0; i < set->nwords; i++) {
+        if (set->words[i] != 0) {
+            return false;
+        }
     }
-    node->value = value;
-    node->next = NULL;
-    return node;
+    return true;
 }
 
 /**
- * Return true if the given IntSet is empty.
+ * Return the number of members of the given IntSet.
  */
-bool
-IntSet_is_empty(const IntSet *set) {
-    return set->first == NULL;
+int
+IntSet_size(const IntSet *set) {
+    int size = 0;
+    for (int i = 0; i < set->nwords; i++) {
+        size += popcount64(set->words[i]);
+    }
+    return size;
+}
+
+/**
+ * Remove every member of the given IntSet.
+ */
+void
+IntSet_clear(IntSet *set) {
+    memset(set->words, 0, set->nwords*sizeof(uint64_t));
 }
 
 /**
  * Add given int to the given IntSet (if it's not already there).
+ * Only non-negative values can be stored.
  */
 void
 IntSet_add(IntSet *set, int value) {
-    if (!IntSet_contains(set, value)) {
-        // Add at front
-        IntSetNode *node = IntSetNode_new(value);
-        node->next = set->first;
-        set->first = node;
+    if (value < 0) {
+        abort();
+    }
+    int word = value / WORD_BITS;
+    if (word >= set->nwords) {
+        int nwords = set->nwords * 2;
+        IntSet_grow(set, nwords > word ? nwords : word + 1);
     }
+    set->words[word] |= (uint64_t)1 << (value % WORD_BITS);
 }
 
 /**
@@ -106,12 +178,10 @@ IntSet_add(IntSet *set, int value) {
  */
 bool
 IntSet_contains(const IntSet *set, int value) {
-    for (IntSetNode *node=set->first; node != NULL; node=node->next) {
-        if (node->value == value) {
-            return true;
-        }
+    if (value < 0 || value / WORD_BITS >= set->nwords) {
+        return false;
     }
-    return false;
+    return (set->words[value / WORD_BITS] >> (value % WORD_BITS)) & 1;
 }
 
 /**
@@ -121,8 +191,13 @@ IntSet_contains(const IntSet *set, int value) {
  */
 void
 IntSet_union(IntSet *set1, const IntSet *set2) {
-    for (IntSetNode *node=set2->first; node != NULL; node=node->next) {
-        IntSet_add(set1, node->value);
+    int used = set2->nwords;
+    while (used > 0 && set2->words[used-1] == 0) {
+        used--;
+    }
+    IntSet_grow(set1, used);
+    for (int i = 0; i < used; i++) {
+        set1->words[i] |= set2->words[i];
     }
 }
 
@@ -132,21 +207,81 @@ IntSet_union(IntSet *set1, const IntSet *set2) {
  */
 bool
 IntSet_contains_all(IntSet *set1, IntSet *set2) {
-    for (IntSetNode *node2=set2->first; node2 != NULL; node2=node2->next) {
-        if (!IntSet_contains(set1, node2->value)) {
+    for (int i = 0; i < set2->nwords; i++) {
+        uint64_t word1 = i < set1->nwords ? set1->words[i] : 0;
+        if ((set2->words[i] & ~word1) != 0) {
             return false;
         }
     }
     return true;
 }
 
+/**
+ * Return true if the two given IntSets have at least one member in common.
+ */
+bool
+IntSet_intersects(const IntSet *set1, const IntSet *set2) {
+    int n = set1->nwords < set2->nwords ? set1->nwords : set2->nwords;
+    for (int i = 0; i < n; i++) {
+        if ((set1->words[i] & set2->words[i]) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  * Return true if the two given IntSets contain exactly the same members,
  * otherwise false.
  */
 bool
 IntSet_equals(IntSet *set1, IntSet *set2) {
-    return IntSet_contains_all(set1, set2) && IntSet_contains_all(set2, set1);
+    int n = set1->nwords > set2->nwords ? set1->nwords : set2->nwords;
+    for (int i = 0; i < n; i++) {
+        uint64_t word1 = i < set1->nwords ? set1->words[i] : 0;
+        uint64_t word2 = i < set2->nwords ? set2->words[i] : 0;
+        if (word1 != word2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Return a hash code for the given IntSet. Trailing zero words are
+ * skipped so that equal sets of different capacity hash alike.
+ */
+unsigned int
+IntSet_hash(const IntSet *set) {
+    int used = set->nwords;
+    while (used > 0 && set->words[used-1] == 0) {
+        used--;
+    }
+    uint64_t hash = 14695981039346656037ULL;
+    for (int i = 0; i < used; i++) {
+        hash = (hash ^ set->words[i]) * 1099511628211ULL;
+    }
+    return (unsigned int)(hash ^ (hash >> 32));
+}
+
+/**
+ * Return the smallest member of the given IntSet that is >= from, or -1
+ * if there is no such member.
+ */
+static int
+IntSet_next_member(const IntSet *set, int from) {
+    int i = from / WORD_BITS;
+    if (i >= set->nwords) {
+        return -1;
+    }
+    uint64_t word = set->words[i] & (~(uint64_t)0 << (from % WORD_BITS));
+    while (word == 0) {
+        if (++i >= set->nwords) {
+            return -1;
+        }
+        word = set->words[i];
+    }
+    return i * WORD_BITS + lowest_bit64(word);
 }
 
 /**
@@ -155,20 +290,26 @@ IntSet_equals(IntSet *set1, IntSet *set2) {
  */
 void
 IntSet_iterate(const IntSet *set, void (*func)(int)) {
-    for (IntSetNode *node=set->first; node != NULL; node=node->next) {
-        func(node->value);
+    for (int i = 0; i < set->nwords; i++) {
+        uint64_t word = set->words[i];
+        while (word != 0) {
+            func(i * WORD_BITS + lowest_bit64(word));
+            word &= word - 1;
+        }
     }
 }
 
 /**
  * Return an IntSetIterator for the given IntSet.
+ * Elements are returned in increasing order.
  * Don't forget to free() this when you're done iterating.
  */
 
 IntSetIterator *
 IntSet_iterator(const IntSet *set) {
     IntSetIterator *iterator = (IntSetIterator*)malloc(sizeof(IntSetIterator));
-    iterator->node = set->first;
+    iterator->set = set;
+    iterator->next = IntSet_next_member(set, 0);
     return iterator;
 }
 
@@ -182,22 +323,22 @@ IntSet_iterator(const IntSet *set) {
  */
 bool
 IntSetIterator_has_next(const IntSetIterator *iterator) {
-    return iterator != NULL && iterator->node != NULL;
+    return iterator != NULL && iterator->next >= 0;
 }
 
 int
 IntSetIterator_next(IntSetIterator *iterator) {
-    if (iterator == NULL || iterator->node == NULL) {
+    if (iterator == NULL || iterator->next < 0) {
         abort();
     } else {
-        int value = iterator->node->value;
-        iterator->node = iterator->node->next;
+        int value = iterator->next;
+        iterator->next = IntSet_next_member(iterator->set, value + 1);
         return value;
     }
 }
 
 int IntSet_retrieve_first(IntSet *set) {
-    return set->first->value;
+    return IntSet_next_member(set, 0);
 }
 
 /**
@@ -205,11 +346,13 @@ int IntSet_retrieve_first(IntSet *set) {
  */
 void
 IntSet_print(IntSet *set) {
-    for (IntSetNode *node=set->first; node != NULL; node=node->next) {
-        printf("%d", node->value);
-        if (node->next != NULL) {
+    for (int value = IntSet_next_member(set, 0); value >= 0; ) {
+        int next = IntSet_next_member(set, value + 1);
+        printf("%d", value);
+        if (next >= 0) {
             printf(" ");
         }
+        value = next;
     }
     printf("\n");
 }
@@ -24,6 +24,13 @@ typedef struct IntSet IntSet;
  */
 extern IntSet *IntSet_new();
 
+/**
+ * Allocate, initialize and return a new (empty) IntSet sized for members
+ * in the range 0..n-1. The set still grows if larger values are added,
+ * but sizing it up front avoids reallocating on the hot path.
+ */
+extern IntSet *IntSet_new_with_capacity(int n);
+
 /**
  * Free the memory used for the given IntSet and all its elements.
  */
@@ -34,6 +41,16 @@ extern void IntSet_free(IntSet *set);
  */
 extern bool IntSet_is_empty(const IntSet *set);
 
+/**
+ * Return the number of members of the given IntSet.
+ */
+extern int IntSet_size(const IntSet *set);
+
+/**
+ * Remove every member of the given IntSet.
+ */
+extern void IntSet_clear(IntSet *set);
+
 /**
  * Add given int to the given IntSet (if it's not already there).
  */
@@ -57,12 +74,23 @@ extern void IntSet_union(IntSet *set1, const IntSet *set2);
  */
 extern bool IntSet_contains_all(IntSet *set1, IntSet *set2);
 
+/**
+ * Return true if the two given IntSets have at least one member in common.
+ */
+extern bool IntSet_intersects(const IntSet *set1, const IntSet *set2);
+
 /**
  * Return true if the two given IntSets contain exactly the same members,
  * otherwise false.
  */
 extern bool IntSet_equals(IntSet *set1, IntSet *set2);
 
+/**
+ * Return a hash code for the given IntSet. Sets that are IntSet_equals
+ * have the same hash code, whatever their capacity.
+ */
+extern unsigned int IntSet_hash(const IntSet *set);
+
 /**
  * Call the given function on each element of given IntSet, passing the
  * int value to the function.
@@ -0,0 +1,165 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: IntSetTable.c
+ *
+ * Open-addressing hash table (linear probing) of indexes into an array
+ * of interned IntSets. The index of a set in the array is its number.
+ */
+
+#include <stdlib.h>
+#include "IntSetTable.h"
+
+struct IntSetTable {
+    IntSet **sets;
+    int count;
+    int capacity;
+    int *buckets; // index into sets, or -1 if free
+    int numOfBuckets;
+};
+
+/**
+ * Allocate a bucket array of the given size with every bucket free.
+ */
+static int *
+IntSetTable_new_buckets(int numOfBuckets) {
+    int *buckets = (int*)malloc(numOfBuckets*sizeof(int));
+    if (buckets == NULL) {
+        abort();
+    }
+    for (int i = 0; i < numOfBuckets; i++) {
+        buckets[i] = -1;
+    }
+    return buckets;
+}
+
+/**
+ * Allocate, initialize and return a new (empty) IntSetTable.
+ */
+IntSetTable *
+IntSetTable_new() {
+    IntSetTable *table = (IntSetTable*)malloc(sizeof(IntSetTable));
+    if (table == NULL) {
+        abort();
+    }
+    table->count = 0;
+    table->capacity = 16;
+    table->sets = (IntSet**)malloc(table->capacity*sizeof(IntSet*));
+    if (table->sets == NULL) {
+        abort();
+    }
+    table->numOfBuckets = 64;
+    table->buckets = IntSetTable_new_buckets(table->numOfBuckets);
+    return table;
+}
+
+/**
+ * Free the given IntSetTable and all the IntSets it owns.
+ */
+void
+IntSetTable_free(IntSetTable *table) {
+    for (int i = 0; i < table->count; i++) {
+        IntSet_free(table->sets[i]);
+    }
+    free(table->sets);
+    free(table->buckets);
+    free(table);
+}
+
+/**
+ * Return the bucket holding a set equal to the given one, or the free
+ * bucket where it would go.
+ */
+static int
+IntSetTable_find(IntSetTable *table, IntSet *set) {
+    int mask = table->numOfBuckets - 1;
+    int bucket = IntSet_hash(set) & mask;
+    while (table->buckets[bucket] != -1
+           && !IntSet_equals(table->sets[table->buckets[bucket]], set)) {
+        bucket = (bucket + 1) & mask;
+    }
+    return bucket;
+}
+
+/**
+ * Double the number of buckets and reinsert every set.
+ */
+static void
+IntSetTable_rehash(IntSetTable *table) {
+    free(table->buckets);
+    table->numOfBuckets *= 2;
+    table->buckets = IntSetTable_new_buckets(table->numOfBuckets);
+    for (int i = 0; i < table->count; i++) {
+        table->buckets[IntSetTable_find(table, table->sets[i])] = i;
+    }
+}
+
+/**
+ * Return the number of the given IntSet in the table, adding it with the
+ * next free number if no equal set is there yet. Takes ownership of set.
+ */
+int
+IntSetTable_intern(IntSetTable *table, IntSet *set) {
+    int bucket = IntSetTable_find(table, set);
+    if (table->buckets[bucket] != -1) {
+        IntSet_free(set);
+        return table->buckets[bucket];
+    }
+    if (table->count == table->capacity) {
+        table->capacity *= 2;
+        table->sets = (IntSet**)realloc(table->sets, table->capacity*sizeof(IntSet*));
+        if (table->sets == NULL) {
+            abort();
+        }
+    }
+    int id = table->count++;
+    table->sets[id] = set;
+    table->buckets[bucket] = id;
+    // Keep the load factor at most 1/2 so probe sequences stay short
+    if (2*table->count > table->numOfBuckets) {
+        IntSetTable_rehash(table);
+    }
+    return id;
+}
+
+/**
+ * Return the number of the set equal to the given IntSet, or -1.
+ */
+int
+IntSetTable_lookup(IntSetTable *table, IntSet *set) {
+    return table->buckets[IntSetTable_find(table, set)];
+}
+
+/**
+ * Return the IntSet with the given number.
+ */
+IntSet *
+IntSetTable_get(IntSetTable *table, int id) {
+    return table->sets[id];
+}
+
+/**
+ * Return the number of sets in the given IntSetTable.
+ */
+int
+IntSetTable_size(const IntSetTable *table) {
+    return table->count;
+}
+
+/**
+ * Remove (and free) every set in the given IntSetTable.
+ */
+void
+IntSetTable_clear(IntSetTable *table) {
+    for (int i = 0; i < table->count; i++) {
+        IntSet_free(table->sets[i]);
+    }
+    table->count = 0;
+    for (int i = 0; i < table->numOfBuckets; i++) {
+        table->buckets[i] = -1;
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: IntSetTable.h
+ *
+ * Hash table that interns IntSets, numbering each distinct set in the
+ * order it was first added. Used to map sets of NFA states to DFA states.
+ */
+
+#ifndef _IntSetTable_h
+#define _IntSetTable_h
+
+#include "IntSet.h"
+
+// Partial declaration
+typedef struct IntSetTable IntSetTable;
+
+/**
+ * Allocate, initialize and return a new (empty) IntSetTable.
+ */
+extern IntSetTable *IntSetTable_new();
+
+/**
+ * Free the given IntSetTable and all the IntSets it owns.
+ */
+extern void IntSetTable_free(IntSetTable *table);
+
+/**
+ * Return the number of the given IntSet in the table, adding it with the
+ * next free number if no equal set is there yet.
+ * The table takes ownership of set: it is kept if it was added and freed
+ * otherwise, so the caller must not use it after this call.
+ */
+extern int IntSetTable_intern(IntSetTable *table, IntSet *set);
+
+/**
+ * Return the number of the set equal to the given IntSet, or -1 if there
+ * is no such set in the table. The table does not take ownership of set.
+ */
+extern int IntSetTable_lookup(IntSetTable *table, IntSet *set);
+
+/**
+ * Return the IntSet with the given number. It is still owned by the table.
+ */
+extern IntSet *IntSetTable_get(IntSetTable *table, int id);
+
+/**
+ * Return the number of sets in the given IntSetTable.
+ */
+extern int IntSetTable_size(const IntSetTable *table);
+
+/**
+ * Remove (and free) every set in the given IntSetTable, so that numbering
+ * starts again from 0.
+ */
+extern void IntSetTable_clear(IntSetTable *table);
+
+#endif
@@ -23,7 +23,7 @@ myfunc(int value) {
 
 int
 main(int argc, char **argv) {
-    IntSet set1 = IntSet_new();
+    IntSet *set1 = IntSet_new();
 
     printf("empty set1 contains 2? %d\n", IntSet_contains(set1, 2));
 
@@ -40,7 +40,7 @@ main(int argc, char **argv) {
     printf("iterating over members of set1:\n");
     IntSet_iterate(set1, myfunc);
 
-    IntSet set2 = IntSet_new();
+    IntSet *set2 = IntSet_new();
     IntSet_add(set2, 3);
     printf("created set2 = ");
     IntSet_print(set2);
@@ -59,7 +59,27 @@ main(int argc, char **argv) {
     printf("set1 equals set2? %d\n", IntSet_equals(set1, set2));
     printf("set2 equals set1? %d\n", IntSet_equals(set2, set1));
 
-    printf("freeing both sets\n");
+    printf("set2 size? %d\n", IntSet_size(set2));
+
+    IntSet *set3 = IntSet_new_with_capacity(10);
+    printf("adding 5 and 200 to set3 (capacity 10)\n");
+    IntSet_add(set3, 5);
+    IntSet_add(set3, 200);
+    printf("set3 = ");
+    IntSet_print(set3);
+    printf("set3 contains 200? %d\n", IntSet_contains(set3, 200));
+    printf("set3 contains 201? %d\n", IntSet_contains(set3, 201));
+    printf("set2 intersects set3? %d\n", IntSet_intersects(set2, set3));
+    printf("union set3 into set1\n");
+    IntSet_union(set1, set3);
+    printf("set1 = ");
+    IntSet_print(set1);
+    printf("set1 size? %d\n", IntSet_size(set1));
+    printf("set1 contains_all set3? %d\n", IntSet_contains_all(set1, set3));
+    printf("set1 intersects set3? %d\n", IntSet_intersects(set1, set3));
+
+    printf("freeing all sets\n");
     IntSet_free(set1);
     IntSet_free(set2);
+    IntSet_free(set3);
 }
@@ -0,0 +1,408 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: ahocorasick.c
+ *
+ * The trie is kept as first-child/next-sibling lists while literals are
+ * added. AhoCorasick_finalize walks it breadth-first, so that a node's
+ * failure node (its longest proper suffix that is also in the trie) is
+ * always done before the node itself, and fills in each node's row of the
+ * table with its own children or else its failure node's entries. The
+ * rows are then renumbered as in dfa.c: the root is row 0, nodes where no
+ * literal ends come next, and nodes where one does (itself or through its
+ * failure nodes) come last, from firstMatching on. The scan loop only has
+ * to compare the row offset with one bound to notice either.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "IntSet.h"
+#include "dfasimd.h"
+#include "ahocorasick.h"
+
+//with up to this many bytes that can start a literal, scans skip through
+//input that cannot with find_bytes or find_byteset; with more the skips
+//get too short to be worth it
+#define AC_MAX_START_BYTES 32
+
+//a skip shorter than this costs more than walking the table would, so
+//after one the scan walks the next AC_SKIP_BACKOFF bytes without skipping
+#define AC_SHORT_SKIP 4
+#define AC_SKIP_BACKOFF 64
+
+struct AhoCorasick {
+    //the trie, node 0 being the root
+    int numOfNodes;
+    int nodeCapacity;
+    int *child;            //first child of each node, or -1
+    int *sibling;          //next child of the same parent, or -1
+    unsigned char *byte;   //byte on the edge into each node
+    int *literalAt;        //the first literal ending at each node, or -1
+    int numOfLiterals;
+    int *nextSame;         //literal -> the next one with the same bytes, or -1
+    //the table built by AhoCorasick_finalize, with rows identified by
+    //their offset (row*numOfClasses) into table
+    bool isFinalized;
+    unsigned char classMap[256];
+    int numOfClasses;
+    uint32_t *table;
+    size_t firstMatching;
+    int *rowLiteral;       //row -> the first literal ending at its node, or -1
+    int *rowOut;           //row -> the row of its nearest failure node with
+                           //a literal ending there, or -1
+    int numOfStartBytes;   //bytes that leave the root
+    unsigned char startBytes[3];
+    ByteSet startSet;
+};
+
+//reallocs ptr to hold count elements of the given size, aborting if
+//there is not enough memory
+static void *ac_grow(void *ptr, size_t count, size_t size) {
+    ptr = realloc(ptr, (count > 0 ? count : 1) * size);
+    if (ptr == NULL) {
+        abort();
+    }
+    return ptr;
+}
+
+//adds a trie node entered on the given byte, and returns its number
+static int AhoCorasick_add_node(AhoCorasick* ac, unsigned char byte) {
+    if (ac->numOfNodes == ac->nodeCapacity) {
+        ac->nodeCapacity = ac->nodeCapacity == 0 ? 64 : 2*ac->nodeCapacity;
+        ac->child = (int *)ac_grow(ac->child, ac->nodeCapacity, sizeof(int));
+        ac->sibling = (int *)ac_grow(ac->sibling, ac->nodeCapacity, sizeof(int));
+        ac->byte = (unsigned char *)ac_grow(ac->byte, ac->nodeCapacity, 1);
+        ac->literalAt = (int *)ac_grow(ac->literalAt, ac->nodeCapacity, sizeof(int));
+    }
+    int node = ac->numOfNodes++;
+    ac->child[node] = -1;
+    ac->sibling[node] = -1;
+    ac->byte[node] = byte;
+    ac->literalAt[node] = -1;
+    return node;
+}
+
+/**
+ * Allocate and return a new AhoCorasick matcher without any literals.
+ */
+extern AhoCorasick* AhoCorasick_new() {
+    AhoCorasick *ac = (AhoCorasick *)malloc(sizeof(AhoCorasick));
+    if (ac == NULL) {
+        abort();
+    }
+    ac->numOfNodes = 0;
+    ac->nodeCapacity = 0;
+    ac->child = NULL;
+    ac->sibling = NULL;
+    ac->byte = NULL;
+    ac->literalAt = NULL;
+    ac->numOfLiterals = 0;
+    ac->nextSame = NULL;
+    ac->isFinalized = false;
+    ac->table = NULL;
+    ac->rowLiteral = NULL;
+    ac->rowOut = NULL;
+    AhoCorasick_add_node(ac, 0);
+    return ac;
+}
+
+/**
+ * Free the given AhoCorasick matcher.
+ */
+extern void AhoCorasick_free(AhoCorasick* ac) {
+    free(ac->child);
+    free(ac->sibling);
+    free(ac->byte);
+    free(ac->literalAt);
+    free(ac->nextSame);
+    free(ac->table);
+    free(ac->rowLiteral);
+    free(ac->rowOut);
+    free(ac);
+}
+
+/**
+ * Add the len bytes at literal to the matcher and return its id.
+ */
+extern int AhoCorasick_add(AhoCorasick* ac, const unsigned char *literal, size_t len) {
+    ac->isFinalized = false;
+    int node = 0;
+    for (size_t i = 0; i < len; i++) {
+        int next = ac->child[node];
+        while (next >= 0 && ac->byte[next] != literal[i]) {
+            next = ac->sibling[next];
+        }
+        if (next < 0) {
+            next = AhoCorasick_add_node(ac, literal[i]);
+            ac->sibling[next] = ac->child[node];
+            ac->child[node] = next;
+        }
+        node = next;
+    }
+    int id = ac->numOfLiterals++;
+    ac->nextSame = (int *)ac_grow(ac->nextSame, ac->numOfLiterals, sizeof(int));
+    ac->nextSame[id] = -1;
+    if (ac->literalAt[node] < 0) {
+        ac->literalAt[node] = id;
+    } else {
+        int last = ac->literalAt[node];
+        while (ac->nextSame[last] >= 0) {
+            last = ac->nextSame[last];
+        }
+        ac->nextSame[last] = id;
+    }
+    return id;
+}
+
+/**
+ * Add the given string to the matcher and return its id.
+ */
+extern int AhoCorasick_add_str(AhoCorasick* ac, const char *literal) {
+    return AhoCorasick_add(ac, (const unsigned char *)literal, strlen(literal));
+}
+
+/**
+ * Return the number of literals added to the given matcher.
+ */
+extern int AhoCorasick_get_num_literals(const AhoCorasick* ac) {
+    return ac->numOfLiterals;
+}
+
+/**
+ * Build the dense table of the given matcher.
+ */
+extern void AhoCorasick_finalize(AhoCorasick* ac) {
+    int n = ac->numOfNodes;
+
+    //every byte that appears in a literal gets its own class, and all the
+    //others share class 0, since they lead back to the root from anywhere
+    bool used[256] = {false};
+    for (int node = 1; node < n; node++) {
+        used[ac->byte[node]] = true;
+    }
+    int k = 1;
+    for (int b = 0; b < 256; b++) {
+        ac->classMap[b] = used[b] ? k++ : 0;
+    }
+
+    //breadth-first over the trie, filling in each node's transitions on
+    //every class and its failure node
+    int *order = (int *)ac_grow(NULL, n, sizeof(int));
+    int *fail = (int *)ac_grow(NULL, n, sizeof(int));
+    int *out = (int *)ac_grow(NULL, n, sizeof(int));
+    int *go = (int *)ac_grow(NULL, (size_t)n*k, sizeof(int));
+    int numOfOrdered = 0;
+    order[numOfOrdered++] = 0;
+    fail[0] = 0;
+    out[0] = -1;
+    for (int head = 0; head < numOfOrdered; head++) {
+        int u = order[head];
+        for (int c = 0; c < k; c++) {
+            go[(size_t)u*k + c] = u == 0 ? 0 : go[(size_t)fail[u]*k + c];
+        }
+        for (int v = ac->child[u]; v >= 0; v = ac->sibling[v]) {
+            int c = ac->classMap[ac->byte[v]];
+            fail[v] = u == 0 ? 0 : go[(size_t)fail[u]*k + c];
+            out[v] = ac->literalAt[fail[v]] >= 0 ? fail[v] : out[fail[v]];
+            go[(size_t)u*k + c] = v;
+            order[numOfOrdered++] = v;
+        }
+    }
+
+    //number the rows: the root, then nodes where nothing ends, then the rest
+    int *rowOf = (int *)ac_grow(NULL, n, sizeof(int));
+    int *nodeOf = (int *)ac_grow(NULL, n, sizeof(int));
+    int row = 0;
+    rowOf[0] = row;
+    nodeOf[row++] = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 1) {
+            ac->firstMatching = (size_t)row*k;
+        }
+        for (int i = 1; i < n; i++) {
+            int u = order[i];
+            bool matching = ac->literalAt[u] >= 0 || out[u] >= 0;
+            if (matching == (pass == 1)) {
+                rowOf[u] = row;
+                nodeOf[row++] = u;
+            }
+        }
+    }
+    if ((size_t)n*k > UINT32_MAX) {
+        abort();
+    }
+    free(ac->table);
+    free(ac->rowLiteral);
+    free(ac->rowOut);
+    ac->numOfClasses = k;
+    ac->table = (uint32_t *)ac_grow(NULL, (size_t)n*k, sizeof(uint32_t));
+    ac->rowLiteral = (int *)ac_grow(NULL, n, sizeof(int));
+    ac->rowOut = (int *)ac_grow(NULL, n, sizeof(int));
+    for (int r = 0; r < n; r++) {
+        int u = nodeOf[r];
+        for (int c = 0; c < k; c++) {
+            ac->table[(size_t)r*k + c] = (uint32_t)rowOf[go[(size_t)u*k + c]]*k;
+        }
+        ac->rowLiteral[r] = ac->literalAt[u];
+        ac->rowOut[r] = out[u] >= 0 ? rowOf[out[u]] : -1;
+    }
+
+    //the bytes that leave the root, for skipping through the rest
+    bool starts[256] = {false};
+    ac->numOfStartBytes = 0;
+    for (int v = ac->child[0]; v >= 0; v = ac->sibling[v]) {
+        starts[ac->byte[v]] = true;
+        if (ac->numOfStartBytes < 3) {
+            ac->startBytes[ac->numOfStartBytes] = ac->byte[v];
+        }
+        ac->numOfStartBytes++;
+    }
+    byteset_init(&ac->startSet, starts);
+
+    free(order);
+    free(fail);
+    free(out);
+    free(go);
+    free(rowOf);
+    free(nodeOf);
+    ac->isFinalized = true;
+}
+
+//returns the position of the next byte from i on that leaves the root
+static size_t AhoCorasick_skip(const AhoCorasick* ac, const unsigned char *input, size_t i, size_t len) {
+    const unsigned char *p;
+    if (ac->numOfStartBytes == 0) {
+        return len;
+    } else if (ac->numOfStartBytes <= 3) {
+        p = find_bytes(input + i, input + len, ac->startBytes, ac->numOfStartBytes);
+    } else {
+        p = find_byteset(input + i, input + len, &ac->startSet);
+    }
+    return p - input;
+}
+
+//runs the automaton from row offset id over input from *pos on, until it
+//enters a row where a literal ends or the input runs out; sets *pos to
+//the position after the last byte read and returns the row offset
+static size_t AhoCorasick_walk(const AhoCorasick* ac, size_t id, const unsigned char *input,
+                               size_t len, size_t *pos) {
+    const uint32_t *table = ac->table;
+    const unsigned char *classMap = ac->classMap;
+    bool skips = ac->numOfStartBytes <= AC_MAX_START_BYTES;
+    size_t resume = 0;   //no skipping before this position
+    size_t i = *pos;
+    while (i < len) {
+        bool skipping = skips && i >= resume;
+        if (id == 0 && skipping) {
+            size_t next = AhoCorasick_skip(ac, input, i, len);
+            if (next - i < AC_SHORT_SKIP) {
+                resume = next + AC_SKIP_BACKOFF;
+                skipping = false;
+            }
+            i = next;
+            if (i == len) {
+                break;
+            }
+        }
+        //while skipping, the root (row 0, which wraps around) also ends
+        //the inner loop; otherwise it runs up to where skipping resumes
+        size_t low = skipping ? 1 : 0;
+        size_t bound = ac->firstMatching - low;
+        size_t stop = skipping || resume > len ? len : resume;
+        do {
+            id = table[id + classMap[input[i++]]];
+        } while (i < stop && id - low < bound);
+        if (id >= ac->firstMatching) {
+            break;
+        }
+    }
+    *pos = i;
+    return id;
+}
+
+/**
+ * Search the given input for the occurrence of a literal that ends first.
+ */
+extern bool AhoCorasick_search(const AhoCorasick* ac, const unsigned char *input, size_t len,
+                               int *id, size_t *end) {
+    if (!ac->isFinalized) {
+        return false;
+    }
+    size_t pos = 0;
+    int literal = ac->literalAt[0];   //the empty literal ends at 0
+    if (literal < 0) {
+        size_t row = AhoCorasick_walk(ac, 0, input, len, &pos) / ac->numOfClasses;
+        if (row*ac->numOfClasses < ac->firstMatching) {
+            return false;
+        }
+        literal = ac->rowLiteral[row] >= 0 ? ac->rowLiteral[row] : ac->rowLiteral[ac->rowOut[row]];
+    }
+    if (id != NULL) {
+        *id = literal;
+    }
+    if (end != NULL) {
+        *end = pos;
+    }
+    return true;
+}
+
+//adds the literals in the chain starting at literal to found, and
+//returns how many of them were new
+static int AhoCorasick_report(const AhoCorasick* ac, int literal, IntSet* found) {
+    int added = 0;
+    for (; literal >= 0; literal = ac->nextSame[literal]) {
+        if (!IntSet_contains(found, literal)) {
+            IntSet_add(found, literal);
+            added++;
+        }
+    }
+    return added;
+}
+
+/**
+ * Set found to the ids of every literal that occurs in the given input.
+ */
+extern int AhoCorasick_find_all(const AhoCorasick* ac, const unsigned char *input, size_t len,
+                                IntSet* found) {
+    IntSet_clear(found);
+    if (!ac->isFinalized) {
+        return -1;
+    }
+    int count = AhoCorasick_report(ac, ac->literalAt[0], found);
+    size_t pos = 0;
+    size_t id = 0;
+    while (pos < len && count < ac->numOfLiterals) {
+        id = AhoCorasick_walk(ac, id, input, len, &pos);
+        if (id < ac->firstMatching) {
+            break;
+        }
+        for (int row = id / ac->numOfClasses; row >= 0; row = ac->rowOut[row]) {
+            count += AhoCorasick_report(ac, ac->rowLiteral[row], found);
+        }
+    }
+    return count;
+}
+
+/**
+ * Return true if the given input ends with one of the literals.
+ */
+extern bool AhoCorasick_ends_with(const AhoCorasick* ac, const unsigned char *input, size_t len) {
+    if (!ac->isFinalized) {
+        return false;
+    }
+    if (ac->literalAt[0] >= 0) {
+        return true;
+    }
+    size_t pos = 0;
+    size_t id = 0;
+    while (pos < len) {
+        id = AhoCorasick_walk(ac, id, input, len, &pos);
+    }
+    return id >= ac->firstMatching;
+}
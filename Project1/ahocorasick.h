@@ -0,0 +1,92 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: ahocorasick.h
+ *
+ * Searching for a set of literal byte strings at once with the
+ * Aho-Corasick automaton: a trie of the literals whose missing edges
+ * follow the failure links, stored as a dense table over byte classes
+ * like a finalized DFA. Each input byte costs one table load no matter
+ * how many literals there are. While no literal is partly matched, the
+ * search skips ahead to the next byte that can start one (see
+ * find_bytes and find_byteset in dfasimd.h).
+ *
+ * This covers the "contains code" and "ends in man" kind of problem
+ * without going through an NFA: AhoCorasick_search and
+ * AhoCorasick_ends_with answer them directly.
+ */
+
+#ifndef _ahocorasick_h
+#define _ahocorasick_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "IntSet.h"
+
+// Partial declaration
+typedef struct AhoCorasick AhoCorasick;
+
+/**
+ * Allocate and return a new AhoCorasick matcher without any literals.
+ */
+extern AhoCorasick* AhoCorasick_new();
+
+/**
+ * Free the given AhoCorasick matcher.
+ */
+extern void AhoCorasick_free(AhoCorasick* ac);
+
+/**
+ * Add the len bytes at literal (any byte values) to the matcher and
+ * return its id: 0 for the first literal added, 1 for the next and so on.
+ */
+extern int AhoCorasick_add(AhoCorasick* ac, const unsigned char *literal, size_t len);
+
+/**
+ * Add the given '\0'-terminated string to the matcher and return its id.
+ */
+extern int AhoCorasick_add_str(AhoCorasick* ac, const char *literal);
+
+/**
+ * Return the number of literals added to the given matcher.
+ */
+extern int AhoCorasick_get_num_literals(const AhoCorasick* ac);
+
+/**
+ * Build the table the searches run on. Call this after adding the last
+ * literal; adding another one means calling it again. The searches only
+ * read the matcher, so one finalized matcher can be shared by threads.
+ * Searching a matcher that has not been finalized since its last literal
+ * was added finds nothing.
+ */
+extern void AhoCorasick_finalize(AhoCorasick* ac);
+
+/**
+ * Search the len bytes at input for the occurrence of a literal that ends
+ * first, taking the longest literal if several end at the same place.
+ * Returns true if there is one, and then sets *id to the literal's id and
+ * *end to the position just past it (either may be NULL). Returns false
+ * if the matcher is not finalized.
+ */
+extern bool AhoCorasick_search(const AhoCorasick* ac, const unsigned char *input, size_t len,
+                               int *id, size_t *end);
+
+/**
+ * Set found to the ids of every literal that occurs in the len bytes at
+ * input (found is cleared first). Returns the number of them, or -1 if
+ * the matcher is not finalized.
+ */
+extern int AhoCorasick_find_all(const AhoCorasick* ac, const unsigned char *input, size_t len,
+                                IntSet* found);
+
+/**
+ * Return true if the len bytes at input end with one of the literals, and
+ * false if the matcher is not finalized.
+ */
+extern bool AhoCorasick_ends_with(const AhoCorasick* ac, const unsigned char *input, size_t len);
+
+#endif
@@ -0,0 +1,109 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: ahocorasick_test.c
+ *
+ * Test program for the Aho-Corasick matcher: overlapping, repeated and
+ * empty literals, and searching before the matcher is finalized.
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include "IntSet.h"
+#include "ahocorasick.h"
+#include "test_util.h"
+
+//checks the first literal AhoCorasick_search finds in the given string
+static void check_search(AhoCorasick* ac, const char *input, int expectedId, int expectedEnd) {
+    int id = -1;
+    size_t end = 0;
+    bool found = AhoCorasick_search(ac, (const unsigned char *)input, strlen(input), &id, &end);
+    printf("search \"%s\" = %d at %d\n", input, found ? id : -1, found ? (int)end : -1);
+    if ((found ? id : -1) != expectedId || (found && (int)end != expectedEnd)) {
+        printf("  FAILED: expected %d at %d\n", expectedId, expectedEnd);
+        test_failures++;
+    }
+}
+
+int
+main(int argc, char **argv) {
+    IntSet *found = IntSet_new();
+    const unsigned char *ushers = (const unsigned char *)"ushers";
+
+    printf("overlapping literals\n");
+    AhoCorasick *ac = AhoCorasick_new();
+    AhoCorasick_add_str(ac, "he");
+    AhoCorasick_add_str(ac, "she");
+    AhoCorasick_add_str(ac, "his");
+    AhoCorasick_add_str(ac, "hers");
+    check("search before finalizing", AhoCorasick_search(ac, ushers, 6, NULL, NULL), false);
+    check("find_all before finalizing", AhoCorasick_find_all(ac, ushers, 6, found), -1);
+    check("ends_with before finalizing", AhoCorasick_ends_with(ac, ushers, 6), false);
+    AhoCorasick_finalize(ac);
+    check_search(ac, "ushers", 1, 4);
+    check_search(ac, "ahis", 2, 4);
+    check_search(ac, "xyz", -1, 0);
+    check("literals in ushers", AhoCorasick_find_all(ac, ushers, 6, found), 3);
+    check("ushers contains he", IntSet_contains(found, 0), true);
+    check("ushers contains she", IntSet_contains(found, 1), true);
+    check("ushers contains his", IntSet_contains(found, 2), false);
+    check("ushers contains hers", IntSet_contains(found, 3), true);
+    check("ushers ends with a literal", AhoCorasick_ends_with(ac, ushers, 6), true);
+    check("usher ends with a literal", AhoCorasick_ends_with(ac, ushers, 5), false);
+    check("ushe ends with a literal", AhoCorasick_ends_with(ac, ushers, 4), true);
+
+    printf("adding a literal after finalizing\n");
+    int r = AhoCorasick_add_str(ac, "r");
+    check("search before finalizing again", AhoCorasick_search(ac, ushers, 6, NULL, NULL), false);
+    AhoCorasick_finalize(ac);
+    check("usher ends with a literal", AhoCorasick_ends_with(ac, ushers, 5), true);
+    check("literals in ushers", AhoCorasick_find_all(ac, ushers, 6, found), 4);
+    check("ushers contains r", IntSet_contains(found, r), true);
+    AhoCorasick_free(ac);
+
+    printf("repeated and nested literals\n");
+    ac = AhoCorasick_new();
+    AhoCorasick_add_str(ac, "abcd");
+    AhoCorasick_add_str(ac, "bc");
+    AhoCorasick_add_str(ac, "bc");
+    AhoCorasick_add_str(ac, "aa");
+    AhoCorasick_add(ac, (const unsigned char *)"a\0b", 3);
+    AhoCorasick_finalize(ac);
+    check_search(ac, "abcd", 1, 3);
+    check("literals in abcd", AhoCorasick_find_all(ac, (const unsigned char *)"abcd", 4, found), 3);
+    check("abcd contains the second bc", IntSet_contains(found, 2), true);
+    check("literals in aaa", AhoCorasick_find_all(ac, (const unsigned char *)"aaa", 3, found), 1);
+    check_search(ac, "xa", -1, 0);
+    check("x a\\0b contains a\\0b",
+          AhoCorasick_find_all(ac, (const unsigned char *)"xa\0b", 4, found) == 1
+          && IntSet_contains(found, 4), true);
+    AhoCorasick_free(ac);
+
+    printf("the empty literal\n");
+    ac = AhoCorasick_new();
+    AhoCorasick_add_str(ac, "abc");
+    int empty = AhoCorasick_add_str(ac, "");
+    AhoCorasick_finalize(ac);
+    check_search(ac, "xyz", empty, 0);
+    check_search(ac, "", empty, 0);
+    check("xyz ends with a literal", AhoCorasick_ends_with(ac, (const unsigned char *)"xyz", 3),
+          true);
+    check("literals in xabc", AhoCorasick_find_all(ac, (const unsigned char *)"xabc", 4, found), 2);
+    check("literals in xyz", AhoCorasick_find_all(ac, (const unsigned char *)"xyz", 3, found), 1);
+    AhoCorasick_free(ac);
+
+    printf("no literals\n");
+    ac = AhoCorasick_new();
+    AhoCorasick_finalize(ac);
+    check_search(ac, "abc", -1, 0);
+    check("literals in abc", AhoCorasick_find_all(ac, (const unsigned char *)"abc", 3, found), 0);
+    AhoCorasick_free(ac);
+
+    IntSet_free(found);
+    return test_summary();
+}
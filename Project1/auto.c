@@ -9,11 +9,441 @@
 #include <stdlib.h>
 #include "dfa.h"
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "IntSet.h"
 #include "nfa.h"
+#include "nfatodfa.h"
+#include "dfamin.h"
+#include "stream.h"
+#include "dfapar.h"
+#include "regexnfa.h"
+#include "multimatch.h"
+#include "prefilter.h"
+#include "search.h"
+#include "dfaops.h"
 
-//runs all of the problems
+//builds the automaton for the given problem name ("1a".."1e" give a DFA,
+//"2a".."2c" an NFA), or compiles name to an NFA if it is a regular
+//expression; prints why and returns false if that is not possible
+static bool build_automaton(const char *name, bool isPattern, DFA **dfa, NFA **nfa) {
+    *dfa = NULL;
+    *nfa = NULL;
+    if (isPattern) {
+        const char *error = NULL;
+        *nfa = regex_to_nfa(name, &error);
+        if (*nfa == NULL) {
+            fprintf(stderr, "auto: bad pattern %s: %s\n", name, error);
+            return false;
+        }
+        return true;
+    }
+    if (strcmp(name, "1a") == 0) *dfa = problem_1_a_dfa();
+    else if (strcmp(name, "1b") == 0) *dfa = problem_1_b_dfa();
+    else if (strcmp(name, "1c") == 0) *dfa = problem_1_c_dfa();
+    else if (strcmp(name, "1d") == 0) *dfa = problem_1_d_dfa();
+    else if (strcmp(name, "1e") == 0) *dfa = problem_1_e_dfa();
+    else if (strcmp(name, "2a") == 0) *nfa = problem_2_a_nfa();
+    else if (strcmp(name, "2b") == 0) *nfa = problem_2_b_nfa();
+    else if (strcmp(name, "2c") == 0) *nfa = problem_2_c_nfa();
+    else {
+        fprintf(stderr, "auto: unknown problem %s\n", name);
+        return false;
+    }
+    if (*dfa != NULL) {
+        DFA_finalize(*dfa);
+    }
+    return true;
+}
+
+//runs the given problem's automaton over a whole file ("-" for standard
+//input), streaming it in chunks; exits 0 if accepted, 1 if not, 2 on error
+static int stream_file(const char *name, bool isPattern, const char *path) {
+    DFA *dfa;
+    NFA *nfa;
+    if (!build_automaton(name, isPattern, &dfa, &nfa)) {
+        return 2;
+    }
+    int fd = strcmp(path, "-") == 0 ? STDIN_FILENO : open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return 2;
+    }
+    int result = dfa != NULL ? DFA_run_fd(dfa, fd) : NFA_run_fd(nfa, fd);
+    if (fd != STDIN_FILENO) {
+        close(fd);
+    }
+    if (dfa != NULL) {
+        DFA_free(dfa);
+    } else {
+        NFA_free(nfa);
+    }
+    if (result < 0) {
+        perror(path);
+        return 2;
+    }
+    printf("%s is %s\n", path, result ? "accepted" : "not accepted");
+    return result ? 0 : 1;
+}
+
+//returns the DFA for the given problem or pattern, determinizing and
+//minimizing it if it is an NFA; returns NULL if it cannot be built
+static DFA* build_dfa(const char *name, bool isPattern) {
+    DFA *dfa;
+    NFA *nfa;
+    if (!build_automaton(name, isPattern, &dfa, &nfa)) {
+        return NULL;
+    }
+    if (nfa != NULL) {
+        DFA *subsets = nfa_to_dfa(nfa);
+        dfa = DFA_minimize(subsets, NULL);
+        DFA_free(subsets);
+        NFA_free(nfa);
+    }
+    DFA_finalize(dfa);
+    return dfa;
+}
+
+//number of lines handed to DFA_run_batch at a time
+#define LINE_BATCH 256
+
+//the most states a DFA can have for scan_mapped_file to test whether it
+//can run backwards, as the test takes quadratic time
+#define REVERSE_MAX_STATES 256
+
+//maps the given file into memory, setting *size to its length; returns
+//NULL (after printing why) if that fails
+static const unsigned char* map_file(const char *path, bool sequential, size_t *size) {
+    int fd = open(path, O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) < 0) {
+        perror(path);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return NULL;
+    }
+    *size = info.st_size;
+    const unsigned char *data = (const unsigned char *)"";
+    if (*size > 0) {
+        void *map = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED) {
+            perror(path);
+            close(fd);
+            return NULL;
+        }
+        if (sequential) {
+            madvise(map, *size, MADV_SEQUENTIAL);
+        }
+        data = (const unsigned char *)map;
+    }
+    close(fd);
+    return data;
+}
+
+//maps the given file into memory and runs the given problem's automaton
+//over it, either as one input (split across all CPUs) or over each line (without its newline),
+//skipping any that lack its required literal (see prefilter.h),
+//and reports how many were accepted; exits 0 if any were, 1 if none
+//were, 2 on error. If only the last few bytes matter (like in problem
+//2a), each input is run backwards from its end instead. Given several
+//names, it runs the intersection of their DFAs, accepting what all of
+//them accept
+static int scan_mapped_file(char **names, int count, bool isPattern, const char *path,
+                            bool lines, bool sequential) {
+    DFA *dfa = build_dfa(names[0], isPattern);
+    if (dfa == NULL) {
+        return 2;
+    }
+    for (int i = 1; i < count; i++) {
+        DFA *other = build_dfa(names[i], isPattern);
+        if (other == NULL) {
+            DFA_free(dfa);
+            return 2;
+        }
+        DFA *both = DFA_intersect(dfa, other, true);
+        DFA_free(dfa);
+        DFA_free(other);
+        DFA_finalize(both);
+        dfa = both;
+    }
+    DFA *reverse = NULL;
+    if (DFA_get_decision_bound(dfa) < 0 && DFA_get_size(dfa) <= REVERSE_MAX_STATES
+        && DFA_is_definite(dfa)) {
+        reverse = DFA_reverse(dfa);
+        DFA_finalize(reverse);
+    }
+    Prefilter *prefilter = Prefilter_new(dfa);
+    const unsigned char *literal;
+    size_t literalLen = Prefilter_get_literal(prefilter, &literal);
+    size_t size;
+    const unsigned char *data = map_file(path, sequential, &size);
+    if (data == NULL) {
+        Prefilter_free(prefilter);
+        DFA_free(dfa);
+        if (reverse != NULL) {
+            DFA_free(reverse);
+        }
+        return 2;
+    }
+
+    long accepted = 0;
+    long total = 0;
+    if (lines && reverse != NULL) {
+        //each line's end decides it, so only newlines are searched for
+        const unsigned char *line = data;
+        const unsigned char *end = data + size;
+        while (line < end) {
+            const unsigned char *newline = memchr(line, '\n', end - line);
+            size_t len = newline != NULL ? (size_t)(newline - line) : (size_t)(end - line);
+            accepted += DFA_run_backwards(reverse, line, len);
+            total++;
+            line += len + 1;
+        }
+        printf("%s: %ld of %ld lines accepted\n", path, accepted, total);
+    } else if (lines) {
+        //collect lines into batches so DFA_run_batch can interleave them
+        const unsigned char *batch[LINE_BATCH];
+        size_t lens[LINE_BATCH];
+        bool results[LINE_BATCH];
+        int count = 0;
+        const unsigned char *line = data;
+        const unsigned char *end = data + size;
+        //the next occurrence of the required literal, if any
+        const unsigned char *hit = Prefilter_find(prefilter, data, end);
+        while (line < end || count > 0) {
+            if (line < end) {
+                const unsigned char *newline = memchr(line, '\n', end - line);
+                size_t len = newline != NULL ? (size_t)(newline - line) : (size_t)(end - line);
+                if (hit != NULL && hit < line) {
+                    hit = Prefilter_find(prefilter, line, end);
+                }
+                if (hit == NULL || hit + literalLen > line + len) {
+                    //the line can't be accepted without the literal
+                    total++;
+                    line += len + 1;
+                    continue;
+                }
+                batch[count] = line;
+                lens[count++] = len;
+                line += len + 1;
+            }
+            if (count == LINE_BATCH || (line >= end && count > 0)) {
+                DFA_run_batch(dfa, batch, lens, count, results);
+                for (int i = 0; i < count; i++) {
+                    accepted += results[i];
+                }
+                total += count;
+                count = 0;
+            }
+        }
+        printf("%s: %ld of %ld lines accepted\n", path, accepted, total);
+    } else if (reverse != NULL) {
+        accepted = DFA_run_backwards(reverse, data, size);
+        printf("%s is %s\n", path, accepted ? "accepted" : "not accepted");
+    } else {
+        if (Prefilter_find(prefilter, data, data + size) != NULL) {
+            accepted = DFA_run_parallel(dfa, data, size, 0);
+        }
+        printf("%s is %s\n", path, accepted ? "accepted" : "not accepted");
+    }
+    if (size > 0) {
+        munmap((void *)data, size);
+    }
+    Prefilter_free(prefilter);
+    DFA_free(dfa);
+    if (reverse != NULL) {
+        DFA_free(reverse);
+    }
+    return accepted > 0 ? 0 : 1;
+}
+
+//maps the given file into memory and runs all of the given patterns over
+//it in one pass, either as one input or over each line (without its
+//newline), and reports which patterns accepted it or how many lines each
+//accepted; exits 0 if any pattern accepted anything, 1 if not, 2 on error
+static int scan_mapped_patterns(char **patterns, int count, const char *path,
+                                bool lines, bool sequential) {
+    MultiMatcher *matcher = MultiMatcher_new();
+    for (int p = 0; p < count; p++) {
+        const char *error = NULL;
+        if (MultiMatcher_add_regex(matcher, patterns[p], &error) < 0) {
+            fprintf(stderr, "auto: bad pattern %s: %s\n", patterns[p], error);
+            MultiMatcher_free(matcher);
+            return 2;
+        }
+    }
+    MultiMatcher_compile(matcher);
+    size_t size;
+    const unsigned char *data = map_file(path, sequential, &size);
+    if (data == NULL) {
+        MultiMatcher_free(matcher);
+        return 2;
+    }
+
+    long *accepted = (long *)calloc(count, sizeof(long));
+    if (accepted == NULL) {
+        abort();
+    }
+    IntSet *matched = IntSet_new_with_capacity(count);
+    long total = 0;
+    const unsigned char *line = data;
+    const unsigned char *end = data + size;
+    while (line < end || (!lines && total == 0)) {
+        size_t len = end - line;
+        if (lines) {
+            const unsigned char *newline = memchr(line, '\n', end - line);
+            len = newline != NULL ? (size_t)(newline - line) : len;
+        }
+        MultiMatcher_run(matcher, line, len, matched);
+        IntSetIterator *iterator = IntSet_iterator(matched);
+        while (IntSetIterator_has_next(iterator)) {
+            accepted[IntSetIterator_next(iterator)]++;
+        }
+        free(iterator);
+        total++;
+        line += len + 1;
+    }
+
+    bool any = false;
+    for (int p = 0; p < count; p++) {
+        if (lines) {
+            printf("%s: %ld of %ld lines accepted by %s\n", path, accepted[p], total, patterns[p]);
+        } else {
+            printf("%s is %s by %s\n", path, accepted[p] ? "accepted" : "not accepted", patterns[p]);
+        }
+        any = any || accepted[p] > 0;
+    }
+    free(accepted);
+    IntSet_free(matched);
+    if (size > 0) {
+        munmap((void *)data, size);
+    }
+    MultiMatcher_free(matcher);
+    return any ? 0 : 1;
+}
+
+//maps the given file into memory and prints the offsets and text of each
+//leftmost-longest match of the given regular expression, one per line;
+//exits 0 if there were any, 1 if not, 2 on error
+static int search_mapped_file(const char *pattern, const char *path, bool sequential) {
+    const char *error = NULL;
+    Searcher *searcher = Searcher_new_regex(pattern, &error);
+    if (searcher == NULL) {
+        fprintf(stderr, "auto: bad pattern %s: %s\n", pattern, error);
+        return 2;
+    }
+    size_t size;
+    const unsigned char *data = map_file(path, sequential, &size);
+    if (data == NULL) {
+        Searcher_free(searcher);
+        return 2;
+    }
+    long found = 0;
+    size_t start;
+    size_t end;
+    SearchIterator *iterator = Searcher_iterator(searcher, data, size, SEARCH_LEFTMOST_LONGEST);
+    while (SearchIterator_next(iterator, &start, &end)) {
+        printf("%zu-%zu: ", start, end);
+        fwrite(data + start, 1, end - start, stdout);
+        printf("\n");
+        found++;
+    }
+    SearchIterator_free(iterator);
+    if (size > 0) {
+        munmap((void *)data, size);
+    }
+    Searcher_free(searcher);
+    return found > 0 ? 0 : 1;
+}
+
+//prints how to run the program
+static int usage(const char *program) {
+    fprintf(stderr, "usage: %s                             run every problem interactively\n", program);
+    fprintf(stderr, "       %s <problem> <file or ->       stream a file through a problem\n", program);
+    fprintf(stderr, "       %s -m [-l] [-s] <problem> <file>  memory-map a file instead\n", program);
+    fprintf(stderr, "       %s [-m [-l] [-s]] -e <pattern> <file>  use a regular expression\n", program);
+    fprintf(stderr, "       %s -m [-l] [-s] -e <pattern> -e <pattern>... <file>  run several at once\n", program);
+    fprintf(stderr, "       %s -m -a [-l] [-s] -e <pattern> -e <pattern>... <file>  require all of them\n", program);
+    fprintf(stderr, "       %s -o [-s] -e <pattern> <file>  print where the pattern matches\n", program);
+    fprintf(stderr, "  -a  accept only what every pattern accepts, running their intersection as one DFA\n");
+    fprintf(stderr, "  -l  test each line separately and count the accepted ones\n");
+    fprintf(stderr, "  -o  print the offsets and text of each match (leftmost-longest)\n");
+    fprintf(stderr, "  -s  advise the kernel the file will be read sequentially\n");
+    fprintf(stderr, "problems are 1a, 1b, 1c, 1d, 1e, 2a, 2b and 2c\n");
+    return 2;
+}
+
+//runs all of the problems, or with arguments "<problem> <file>" runs one
+//problem's automaton over a whole file
 int main(int argc, char* argv[]) {
+    bool mapped = false;
+    bool lines = false;
+    bool sequential = false;
+    bool search = false;
+    bool all = false;
+    char *patterns[argc];
+    int numOfPatterns = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "mlsoae:")) != -1) {
+        switch (opt) {
+        case 'm':
+            mapped = true;
+            break;
+        case 'l':
+            lines = mapped = true;
+            break;
+        case 's':
+            sequential = mapped = true;
+            break;
+        case 'o':
+            search = true;
+            break;
+        case 'a':
+            all = mapped = true;
+            break;
+        case 'e':
+            patterns[numOfPatterns++] = optarg;
+            break;
+        default:
+            return usage(argv[0]);
+        }
+    }
+    if (numOfPatterns > 0) {
+        if (argc - optind != 1 || (numOfPatterns > 1 && !mapped)) {
+            return usage(argv[0]);
+        }
+        if (search) {
+            if (numOfPatterns > 1 || lines || all) {
+                return usage(argv[0]);
+            }
+            return search_mapped_file(patterns[0], argv[optind], sequential);
+        }
+        if (all) {
+            return scan_mapped_file(patterns, numOfPatterns, true, argv[optind], lines, sequential);
+        }
+        if (numOfPatterns > 1) {
+            return scan_mapped_patterns(patterns, numOfPatterns, argv[optind], lines, sequential);
+        }
+        if (mapped) {
+            return scan_mapped_file(patterns, 1, true, argv[optind], lines, sequential);
+        }
+        return stream_file(patterns[0], true, argv[optind]);
+    }
+    if (search || all) {
+        return usage(argv[0]);
+    }
+    if (argc - optind == 2) {
+        if (mapped) {
+            return scan_mapped_file(&argv[optind], 1, false, argv[optind+1], lines, sequential);
+        }
+        return stream_file(argv[optind], false, argv[optind+1]);
+    }
+    if (argc != 1) {
+        return usage(argv[0]);
+    }
     printf("\n");
     problem_1_a();
     printf("\n");
@@ -4,28 +4,64 @@
  * Net ID: skaveti, rracico3, bneupane
  */
 
-#ifndef _dfa_h
-#define _dfa_h
-
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include "dfa.h"
+#include "dfasimd.h"
 #include <string.h>
+#include <stdint.h>
+
+//a state that stays put on every byte but count (1 to 3) of them, which
+//can be skipped through by searching for those bytes
+typedef struct {
+    unsigned char count;     //0 if the state has more exits
+    unsigned char bytes[3];
+} DFA_ACCEL;
 
 typedef struct { //creates a STATES struct whcih includes transitions
-                 //for 128 characters
-    int transition[128];
+                 //for every byte value
+    int transition[DFA_NUM_SYMBOLS];
     bool isAccepting;
 
 }STATES;
 
-typedef struct { //creates a DFA struct with a variable for number of states,
-                 //what the current state is, and a pointer array of STATES
+struct DFA { //creates a DFA struct with a variable for number of states,
+             //what the current state is, and a pointer array of STATES
     int numOfStates;
     int currentState;
     STATES* stateArray;
-}DFA;
+    //compact copy of stateArray built by DFA_finalize: bytes with identical
+    //columns share a class, and each state has a row with one entry per
+    //class. Rows are identified by their offset into table (row*numOfClasses)
+    //so a step is one load and one add. Row 0 is an explicit dead row that
+    //loops to itself, then come the rejecting states and then, from
+    //firstAccepting on, the accepting ones. Entries are stateBytes (1, 2 or
+    //4) wide, the narrowest that holds every offset
+    bool isFinalized;
+    unsigned char classMap[256];
+    int numOfClasses;
+    int stateBytes;
+    void *table;
+    size_t firstAccepting;
+    size_t firstTrapped;
+    size_t *rowOf;    //state -> its row offset
+    int *stateOf;     //row number -> state, -1 for the dead row
+    //for each state, whether the outcome is already settled there: an
+    //accepting trap only leads to accepting states with its own tag, and a
+    //rejecting trap can never reach an accepting or tagged one. Rejecting
+    //traps share the dead row and accepting traps get the rows from
+    //firstTrapped on, so runs stop in either
+    unsigned char *trap;
+    int *tags;             //for each state, NULL until a tag is set
+    DFA_ACCEL *accel;      //for each state
+    bool hasAccel;
+    //for DFAs small enough to fit (with a dead state) in one vector, one
+    //16-byte row of successors per class, run by shuffle_run
+    unsigned char (*shuffle)[SHUFFLE_MAX_STATES];
+    unsigned shuffleStops;   //the dead state and accepting traps, as a mask
+    bool useShuffle;
+};
 
 
 
@@ -37,11 +73,23 @@ extern DFA* DFA_new(int nstates){
     dfa->numOfStates = nstates;
     dfa->currentState = 0;
     dfa->stateArray = (STATES *)malloc(nstates*sizeof(STATES));
+    dfa->isFinalized = false;
+    dfa->numOfClasses = 0;
+    dfa->stateBytes = 0;
+    dfa->table = NULL;
+    dfa->rowOf = NULL;
+    dfa->stateOf = NULL;
+    dfa->trap = NULL;
+    dfa->tags = NULL;
+    dfa->accel = NULL;
+    dfa->hasAccel = false;
+    dfa->shuffle = NULL;
+    dfa->useShuffle = true;
     for (int i = 0; i < nstates; i++) {
         dfa->stateArray[i].isAccepting = false;
     }
     for (int i = 0; i < nstates; i++) {
-        for (int j = 0; j < 128; j++) {
+        for (int j = 0; j < DFA_NUM_SYMBOLS; j++) {
             dfa->stateArray[i].transition[j] = -1;
         }
     }
@@ -53,13 +101,20 @@ extern DFA* DFA_new(int nstates){
  */
 extern void DFA_free(DFA* dfa){
     free(dfa->stateArray);
+    free(dfa->table);
+    free(dfa->rowOf);
+    free(dfa->stateOf);
+    free(dfa->trap);
+    free(dfa->tags);
+    free(dfa->accel);
+    free(dfa->shuffle);
     free(dfa);
 };
 
 /**
  * Return the number of states in the given DFA.
  */
-extern int DFA_get_size(DFA* dfa){
+extern int DFA_get_size(const DFA* dfa){
     return dfa->numOfStates;
 }
 
@@ -68,7 +123,7 @@ extern int DFA_get_size(DFA* dfa){
  * state src on input symbol sym.
  */
 extern int DFA_get_transition(DFA* dfa, int src, char sym){
-    return dfa->stateArray[src].transition[sym];
+    return dfa->stateArray[src].transition[(unsigned char)sym];
 }
 
 /**
@@ -76,7 +131,8 @@ extern int DFA_get_transition(DFA* dfa, int src, char sym){
  * sym to be the state dst.
  */
 extern void DFA_set_transition(DFA* dfa, int src, char sym, int dst){
-    dfa->stateArray[src].transition[sym] = dst;
+    dfa->isFinalized = false;
+    dfa->stateArray[src].transition[(unsigned char)sym] = dst;
 }
 
 /**
@@ -85,8 +141,9 @@ extern void DFA_set_transition(DFA* dfa, int src, char sym, int dst){
  * two states.
  */
 extern void DFA_set_transition_str(DFA* dfa, int src, char *str, int dst){
+    dfa->isFinalized = false;
     for (int i = 0; str[i] != '\0'; i++) {
-        dfa->stateArray[src].transition[str[i]] = dst;
+        dfa->stateArray[src].transition[(unsigned char)str[i]] = dst;
     }
 }
 
@@ -95,18 +152,20 @@ extern void DFA_set_transition_str(DFA* dfa, int src, char *str, int dst){
  * Another shortcut method.
  */
 extern void DFA_set_transition_all(DFA* dfa, int src, int dst){
-    for (int i = 0; i < 128; i++) {
+    dfa->isFinalized = false;
+    for (int i = 0; i < DFA_NUM_SYMBOLS; i++) {
         dfa->stateArray[src].transition[i] = dst;
     }
 }
 //sets the transition for all characters except for the
 //characters in exc which will not be able to transition
 extern void DFA_set_transition_exception(DFA* dfa, int src, int dst, char* exc) {
-    for (int i = 0; i < 128; i++) {
+    dfa->isFinalized = false;
+    for (int i = 0; i < DFA_NUM_SYMBOLS; i++) {
         dfa->stateArray[src].transition[i] = dst;
     }
     for (int i = 0; exc[i] != '\0'; i++) {
-        dfa->stateArray[src].transition[exc[i]] = -1;
+        dfa->stateArray[src].transition[(unsigned char)exc[i]] = -1;
     }
 }
 
@@ -114,6 +173,7 @@ extern void DFA_set_transition_exception(DFA* dfa, int src, int dst, char* exc)
  * Set whether the given DFA's state is accepting or not.
  */
 extern void DFA_set_accepting(DFA* dfa, int state, bool value){
+    dfa->isFinalized = false;
     dfa->stateArray[state].isAccepting = value;
 }
 
@@ -124,50 +184,841 @@ extern bool DFA_get_accepting(DFA* dfa, int state){
     return dfa->stateArray[state].isAccepting;
 }
 
+/**
+ * Set the tag of the given DFA's state.
+ */
+extern void DFA_set_tag(DFA* dfa, int state, int tag){
+    dfa->isFinalized = false;
+    if (dfa->tags == NULL) {
+        dfa->tags = (int *)calloc(dfa->numOfStates + 1, sizeof(int));
+        if (dfa->tags == NULL) {
+            abort();
+        }
+    }
+    dfa->tags[state] = tag;
+}
+
+/**
+ * Return the tag of the given DFA's state (0 unless one was set).
+ */
+extern int DFA_get_tag(const DFA* dfa, int state){
+    return dfa->tags != NULL ? dfa->tags[state] : 0;
+}
+
+//returns the state reached from src on byte b
+static int DFA_column_entry(DFA* dfa, int src, int b) {
+    return dfa->stateArray[src].transition[b];
+}
+
+//values of dfa->trap
+#define DFA_TRAP_NONE 0
+#define DFA_TRAP_ACCEPT 1
+#define DFA_TRAP_REJECT 2
+
+//marks with value every state not yet marked that can reach (backwards
+//over the given predecessor lists) a state already in the worklist
+static void DFA_mark_backwards(unsigned char *mark, int *worklist, int count,
+                               const int *first, const int *preds) {
+    while (count > 0) {
+        int s = worklist[--count];
+        for (int i = first[s]; i < first[s+1]; i++) {
+            if (!mark[preds[i]]) {
+                mark[preds[i]] = 1;
+                worklist[count++] = preds[i];
+            }
+        }
+    }
+}
+
+//fills dfa->trap: states that cannot reach an accepting or tagged state
+//are rejecting traps, and states that cannot reach a rejecting state, a
+//state with another tag or get stuck are accepting traps
+static void DFA_find_traps(DFA* dfa, const int *representative, int numOfClasses) {
+    int n = dfa->numOfStates;
+    //predecessor lists, one entry per (state, class) edge
+    int *first = (int *)calloc(n + 1, sizeof(int));
+    int *preds = (int *)calloc((size_t)n*numOfClasses + 1, sizeof(int));
+    int *worklist = (int *)malloc((n + 1)*sizeof(int));
+    unsigned char *canAccept = (unsigned char *)calloc(n + 1, 1);
+    unsigned char *canReject = (unsigned char *)calloc(n + 1, 1);
+    if (first == NULL || preds == NULL || worklist == NULL || canAccept == NULL || canReject == NULL) {
+        abort();
+    }
+    for (int s = 0; s < n; s++) {
+        for (int c = 0; c < numOfClasses; c++) {
+            int next = DFA_column_entry(dfa, s, representative[c]);
+            if (next >= 0) {
+                first[next + 1]++;
+            }
+        }
+    }
+    for (int s = 0; s < n; s++) {
+        first[s + 1] += first[s];
+    }
+    int *fill = worklist;
+    memcpy(fill, first, n*sizeof(int));
+    for (int s = 0; s < n; s++) {
+        for (int c = 0; c < numOfClasses; c++) {
+            int next = DFA_column_entry(dfa, s, representative[c]);
+            if (next >= 0) {
+                preds[fill[next]++] = s;
+            }
+        }
+    }
+
+    int count = 0;
+    for (int s = 0; s < n; s++) {
+        if (dfa->stateArray[s].isAccepting || DFA_get_tag(dfa, s) != 0) {
+            canAccept[s] = 1;
+            worklist[count++] = s;
+        }
+    }
+    DFA_mark_backwards(canAccept, worklist, count, first, preds);
+    count = 0;
+    for (int s = 0; s < n; s++) {
+        bool leaves = false;   //gets stuck or changes tag
+        for (int c = 0; c < numOfClasses && !leaves; c++) {
+            int next = DFA_column_entry(dfa, s, representative[c]);
+            leaves = next < 0 || DFA_get_tag(dfa, next) != DFA_get_tag(dfa, s);
+        }
+        if (leaves || !dfa->stateArray[s].isAccepting) {
+            canReject[s] = 1;
+            worklist[count++] = s;
+        }
+    }
+    DFA_mark_backwards(canReject, worklist, count, first, preds);
+
+    free(dfa->trap);
+    dfa->trap = (unsigned char *)malloc(n + 1);
+    if (dfa->trap == NULL) {
+        abort();
+    }
+    for (int s = 0; s < n; s++) {
+        dfa->trap[s] = !canAccept[s] ? DFA_TRAP_REJECT
+            : !canReject[s] ? DFA_TRAP_ACCEPT : DFA_TRAP_NONE;
+    }
+    free(first);
+    free(preds);
+    free(worklist);
+    free(canAccept);
+    free(canReject);
+}
+
+/**
+ * Build the byte-class transition table used by DFA_execute.
+ */
+extern void DFA_finalize(DFA* dfa){
+    //hash each byte's column of transitions, then give bytes with equal
+    //columns the same class (comparing columns when hashes collide)
+    unsigned long long hash[256];
+    for (int b = 0; b < 256; b++) {
+        hash[b] = 14695981039346656037ULL;
+        for (int s = 0; s < dfa->numOfStates; s++) {
+            hash[b] = (hash[b] ^ (unsigned)DFA_column_entry(dfa, s, b)) * 1099511628211ULL;
+        }
+    }
+    int representative[256];
+    int numOfClasses = 0;
+    for (int b = 0; b < 256; b++) {
+        int class = -1;
+        for (int c = 0; c < numOfClasses && class < 0; c++) {
+            int r = representative[c];
+            if (hash[r] != hash[b]) {
+                continue;
+            }
+            bool same = true;
+            for (int s = 0; s < dfa->numOfStates && same; s++) {
+                same = DFA_column_entry(dfa, s, r) == DFA_column_entry(dfa, s, b);
+            }
+            if (same) {
+                class = c;
+            }
+        }
+        if (class < 0) {
+            class = numOfClasses++;
+            representative[class] = b;
+        }
+        dfa->classMap[b] = class;
+    }
+
+    DFA_find_traps(dfa, representative, numOfClasses);
+
+    //find the states that loop to themselves on all but a few bytes
+    free(dfa->accel);
+    dfa->accel = (DFA_ACCEL *)calloc(dfa->numOfStates + 1, sizeof(DFA_ACCEL));
+    if (dfa->accel == NULL) {
+        abort();
+    }
+    dfa->hasAccel = false;
+    for (int s = 0; s < dfa->numOfStates; s++) {
+        DFA_ACCEL *accel = &dfa->accel[s];
+        int exits = 0;
+        for (int b = 0; b < 256 && exits <= 3; b++) {
+            if (DFA_column_entry(dfa, s, b) != s) {
+                if (exits < 3) {
+                    accel->bytes[exits] = b;
+                }
+                exits++;
+            }
+        }
+        if (exits <= 3 && dfa->trap[s] == DFA_TRAP_NONE) {
+            accel->count = exits;
+            dfa->hasAccel = dfa->hasAccel || exits > 0;
+        } else {
+            accel->count = 0;
+        }
+    }
+
+    //number the rows: dead first (shared by the rejecting traps), then
+    //rejecting states, then accepting states, then accepting traps
+    int numOfRows = 1;
+    for (int s = 0; s < dfa->numOfStates; s++) {
+        numOfRows += dfa->trap[s] != DFA_TRAP_REJECT;
+    }
+    free(dfa->rowOf);
+    free(dfa->stateOf);
+    dfa->rowOf = (size_t *)malloc((dfa->numOfStates + 1)*sizeof(size_t));
+    dfa->stateOf = (int *)malloc(numOfRows*sizeof(int));
+    if (dfa->rowOf == NULL || dfa->stateOf == NULL) {
+        abort();
+    }
+    int row = 0;
+    dfa->stateOf[row++] = -1;
+    for (int s = 0; s < dfa->numOfStates; s++) {
+        dfa->rowOf[s] = 0;
+    }
+    for (int pass = 0; pass < 3; pass++) {
+        if (pass == 1) {
+            dfa->firstAccepting = (size_t)row*numOfClasses;
+        } else if (pass == 2) {
+            dfa->firstTrapped = (size_t)row*numOfClasses;
+        }
+        for (int s = 0; s < dfa->numOfStates; s++) {
+            int trap = dfa->trap[s];
+            bool accepting = dfa->stateArray[s].isAccepting;
+            if ((pass == 0 && trap == DFA_TRAP_NONE && !accepting)
+                || (pass == 1 && trap == DFA_TRAP_NONE && accepting)
+                || (pass == 2 && trap == DFA_TRAP_ACCEPT)) {
+                dfa->rowOf[s] = (size_t)row*numOfClasses;
+                dfa->stateOf[row++] = s;
+            }
+        }
+    }
+
+    free(dfa->table);
+    size_t entries = (size_t)numOfRows*numOfClasses;
+    size_t largest = entries - numOfClasses;
+    dfa->numOfClasses = numOfClasses;
+    dfa->stateBytes = largest <= UINT8_MAX ? 1 : largest <= UINT16_MAX ? 2 : 4;
+    if (largest > INT32_MAX) {
+        abort();
+    }
+    dfa->table = malloc(entries*dfa->stateBytes);
+    if (dfa->table == NULL) {
+        abort();
+    }
+    for (int r = 0; r < numOfRows; r++) {
+        int s = dfa->stateOf[r];
+        for (int c = 0; c < numOfClasses; c++) {
+            int next = s < 0 ? -1 : DFA_column_entry(dfa, s, representative[c]);
+            size_t offset = next < 0 ? 0 : dfa->rowOf[next];    //0 for rejecting traps
+            size_t i = (size_t)r*numOfClasses + c;
+            if (dfa->stateBytes == 1) {
+                ((uint8_t *)dfa->table)[i] = (uint8_t)offset;
+            } else if (dfa->stateBytes == 2) {
+                ((uint16_t *)dfa->table)[i] = (uint16_t)offset;
+            } else {
+                ((int32_t *)dfa->table)[i] = (int32_t)offset;
+            }
+        }
+    }
+
+    //the shuffle tables need a spare slot for the dead state, which maps
+    //to itself on every class
+    free(dfa->shuffle);
+    dfa->shuffle = NULL;
+    int sink = dfa->numOfStates;
+    if (dfa->numOfStates > 0 && dfa->numOfStates < SHUFFLE_MAX_STATES) {
+        dfa->shuffle = malloc((size_t)numOfClasses*sizeof(*dfa->shuffle));
+        if (dfa->shuffle == NULL) {
+            abort();
+        }
+        for (int c = 0; c < numOfClasses; c++) {
+            for (int s = 0; s < SHUFFLE_MAX_STATES; s++) {
+                int next = s < sink ? DFA_column_entry(dfa, s, representative[c]) : sink;
+                if (next < 0 || (next < sink && dfa->trap[next] == DFA_TRAP_REJECT)) {
+                    next = sink;
+                }
+                dfa->shuffle[c][s] = (unsigned char)next;
+            }
+        }
+        dfa->shuffleStops = 1u << sink;
+        for (int s = 0; s < sink; s++) {
+            if (dfa->trap[s] == DFA_TRAP_ACCEPT) {
+                dfa->shuffleStops |= 1u << s;
+            }
+        }
+    }
+    dfa->isFinalized = true;
+}
+
+/**
+ * Return the number of input byte classes in the finalized DFA.
+ */
+extern int DFA_get_num_classes(DFA* dfa){
+    if (!dfa->isFinalized) {
+        DFA_finalize(dfa);
+    }
+    return dfa->numOfClasses;
+}
+
+/**
+ * Choose whether DFA_run may use the vector shuffle kernel for DFAs with
+ * fewer than 16 states (the default), or always walk the transition table.
+ * Both give the same results; this exists for benchmarking.
+ */
+extern void DFA_set_shuffle_kernel(DFA* dfa, bool enabled){
+    dfa->useShuffle = enabled;
+}
+
 //sets the current state of the DFA
 void DFA_set_current_state(DFA *dfa, int statenum) {
     dfa->currentState = statenum;
 }
 
+//how many bytes the table walk takes between checks for the dead row or an
+//accepting trap; both only lead to rows like themselves, so running past
+//them is harmless
+#define DFA_TRAP_CHECK 32
+
+//one loop over the finalized table per entry width, so the hot loop does
+//fixed-size loads, and per direction (at gives the index of the i'th byte
+//read); each takes and returns a row offset
+#define DFA_TABLE_RUN(name, type, at)                                       \
+static size_t name(const DFA* dfa, size_t id, const unsigned char *input, size_t len){ \
+    const type *table = (const type *)dfa->table;                           \
+    const unsigned char *classMap = dfa->classMap;                          \
+    size_t lastLive = dfa->firstTrapped - 1;                                \
+    size_t i = 0;                                                           \
+    while (i < len && id - 1 < lastLive) {  /* 0 wraps around */            \
+        size_t end = len - i > DFA_TRAP_CHECK ? i + DFA_TRAP_CHECK : len;   \
+        for (; i < end; i++) {                                              \
+            id = table[id + classMap[input[at]]];                           \
+        }                                                                   \
+    }                                                                       \
+    return id;                                                              \
+}
+
+DFA_TABLE_RUN(DFA_run_table8, uint8_t, i)
+DFA_TABLE_RUN(DFA_run_table16, uint16_t, i)
+DFA_TABLE_RUN(DFA_run_table32, int32_t, i)
+DFA_TABLE_RUN(DFA_run_table8_back, uint8_t, len - 1 - i)
+DFA_TABLE_RUN(DFA_run_table16_back, uint16_t, len - 1 - i)
+DFA_TABLE_RUN(DFA_run_table32_back, int32_t, len - 1 - i)
+
+//returns the row offset the finalized table goes to from row offset id on
+//the given class
+static inline size_t DFA_table_entry(const DFA* dfa, size_t id, int class){
+    if (dfa->stateBytes == 1) {
+        return ((const uint8_t *)dfa->table)[id + class];
+    } else if (dfa->stateBytes == 2) {
+        return ((const uint16_t *)dfa->table)[id + class];
+    }
+    return ((const int32_t *)dfa->table)[id + class];
+}
+
+//returns the state whose row is at offset id, or -1 for the dead row
+static inline int DFA_row_state(const DFA* dfa, size_t id){
+    return dfa->stateOf[id / dfa->numOfClasses];
+}
+
+//runs a finalized DFA over len bytes from a state that is not trapped,
+//with the shuffle kernel or the table walk (backwards from the last byte
+//if asked, which only the table walk does), and returns the state reached
+//(-1 if it gets stuck); like DFA_step it may stop in an accepting trap
+static int DFA_run_kernel(const DFA* dfa, int state, const unsigned char *input, size_t len,
+                          bool backwards){
+    if (backwards) {
+        size_t id = dfa->rowOf[state];
+        if (dfa->stateBytes == 1) {
+            id = DFA_run_table8_back(dfa, id, input, len);
+        } else if (dfa->stateBytes == 2) {
+            id = DFA_run_table16_back(dfa, id, input, len);
+        } else {
+            id = DFA_run_table32_back(dfa, id, input, len);
+        }
+        return DFA_row_state(dfa, id);
+    }
+    if (dfa->shuffle != NULL && dfa->useShuffle) {
+        int sink = dfa->numOfStates;
+        state = shuffle_run((const unsigned char (*)[SHUFFLE_MAX_STATES])dfa->shuffle,
+                            dfa->classMap, dfa->shuffleStops, state, input, len);
+        return state == sink ? -1 : state;
+    }
+    size_t id = dfa->rowOf[state];
+    if (dfa->stateBytes == 1) {
+        id = DFA_run_table8(dfa, id, input, len);
+    } else if (dfa->stateBytes == 2) {
+        id = DFA_run_table16(dfa, id, input, len);
+    } else {
+        id = DFA_run_table32(dfa, id, input, len);
+    }
+    return DFA_row_state(dfa, id);
+}
+
+//how many bytes are run between looking for a state that can be skipped
+//through with find_bytes
+#define DFA_ACCEL_BLOCK 32
+
+//runs the DFA over len bytes starting from state and returns the state it
+//ends in, or -1 if it gets stuck; on a finalized DFA it stops as soon as
+//the outcome is settled, returning -1 in a rejecting trap and the state
+//it entered an accepting trap in. Only reads the DFA, so it is safe to
+//call from several threads at once on a finalized DFA
+static int DFA_step(const DFA* dfa, int state, const unsigned char *input, size_t len){
+    if (state < 0) {
+        return -1;
+    }
+    if (!dfa->isFinalized) {
+        for (size_t i = 0; i < len; i++) {
+            state = dfa->stateArray[state].transition[input[i]];
+            if (state == -1) {
+                return -1;
+            }
+        }
+        return state;
+    }
+    if (dfa->trap[state] != DFA_TRAP_NONE) {
+        return dfa->trap[state] == DFA_TRAP_REJECT ? -1 : state;
+    }
+    if (!dfa->hasAccel) {
+        return DFA_run_kernel(dfa, state, input, len, false);
+    }
+    //between blocks, a state that only leaves on a few bytes skips straight
+    //to the next of them
+    const unsigned char *end = input + len;
+    while (input < end) {
+        const DFA_ACCEL *accel = &dfa->accel[state];
+        if (accel->count > 0) {
+            input = find_bytes(input, end, accel->bytes, accel->count);
+            if (input == end) {
+                break;
+            }
+        }
+        size_t block = end - input < DFA_ACCEL_BLOCK ? (size_t)(end - input) : DFA_ACCEL_BLOCK;
+        state = DFA_run_kernel(dfa, state, input, block, false);
+        input += block;
+        if (state < 0 || dfa->trap[state] != DFA_TRAP_NONE) {
+            break;
+        }
+    }
+    return state;
+}
+
+//like DFA_step, but reads the len bytes from input[len-1] down to input[0];
+//there is no skipping ahead, as find_bytes only searches forwards
+static int DFA_step_backwards(const DFA* dfa, int state, const unsigned char *input, size_t len){
+    if (state < 0) {
+        return -1;
+    }
+    if (!dfa->isFinalized) {
+        for (size_t i = len; i > 0; i--) {
+            state = dfa->stateArray[state].transition[input[i - 1]];
+            if (state == -1) {
+                return -1;
+            }
+        }
+        return state;
+    }
+    if (dfa->trap[state] != DFA_TRAP_NONE) {
+        return dfa->trap[state] == DFA_TRAP_REJECT ? -1 : state;
+    }
+    return DFA_run_kernel(dfa, state, input, len, true);
+}
+
 /**
  * Run the given DFA on the given input string, and return true if it accepts
  * the input, otherwise false.
  */
 extern bool DFA_execute(DFA* dfa, char *input){
-    for (int i = 0; input[i] != '\0'; i++) {
-        int dst = dfa->stateArray[dfa->currentState].transition[input[i]];
-        DFA_set_current_state(dfa, dst);
-        if (dfa->currentState == -1) {
-            return false;
+    if (!dfa->isFinalized) {
+        DFA_finalize(dfa);
+    }
+    int state = DFA_step(dfa, dfa->currentState, (const unsigned char *)input, strlen(input));
+    DFA_set_current_state(dfa, state);
+    return state != -1 && DFA_get_accepting(dfa, state);
+}
+
+/**
+ * Run the given DFA from its start state on the len bytes at input
+ * without modifying the DFA.
+ */
+extern bool DFA_run(const DFA* dfa, const unsigned char *input, size_t len){
+    int state = DFA_step(dfa, dfa->numOfStates > 0 ? 0 : -1, input, len);
+    return state != -1 && dfa->stateArray[state].isAccepting;
+}
+
+/**
+ * Run the given DFA from its start state on the len bytes at input, last
+ * byte first, without modifying the DFA.
+ */
+extern bool DFA_run_backwards(const DFA* dfa, const unsigned char *input, size_t len){
+    int state = DFA_step_backwards(dfa, dfa->numOfStates > 0 ? 0 : -1, input, len);
+    return state != -1 && dfa->stateArray[state].isAccepting;
+}
+
+/**
+ * Return how many bytes a finalized DFA can read before its outcome is
+ * always decided, or -1 if there is no such bound.
+ */
+extern int DFA_get_decision_bound(const DFA* dfa){
+    int n = dfa->numOfStates;
+    if (!dfa->isFinalized || n == 0) {
+        return -1;
+    }
+    //longest path from the start through undecided states, in topological
+    //order (Kahn); a cycle among them leaves some never ordered
+    int *indegree = (int *)calloc(n, sizeof(int));
+    int *longest = (int *)calloc(n, sizeof(int));
+    int *order = (int *)malloc(n*sizeof(int));
+    if (indegree == NULL || longest == NULL || order == NULL) {
+        abort();
+    }
+    int numOfUndecided = 0;
+    for (int s = 0; s < n; s++) {
+        if (dfa->trap[s] != DFA_TRAP_NONE) {
+            continue;
+        }
+        numOfUndecided++;
+        for (int b = 0; b < DFA_NUM_SYMBOLS; b++) {
+            int t = dfa->stateArray[s].transition[b];
+            if (t >= 0 && dfa->trap[t] == DFA_TRAP_NONE) {
+                indegree[t]++;
+            }
+        }
+    }
+    int numOfOrdered = 0;
+    for (int s = 0; s < n; s++) {
+        if (dfa->trap[s] == DFA_TRAP_NONE && indegree[s] == 0) {
+            order[numOfOrdered++] = s;
+        }
+    }
+    longest[0] = dfa->trap[0] == DFA_TRAP_NONE ? 1 : 0;
+    int bound = longest[0];
+    for (int i = 0; i < numOfOrdered; i++) {
+        int s = order[i];
+        for (int b = 0; b < DFA_NUM_SYMBOLS; b++) {
+            int t = dfa->stateArray[s].transition[b];
+            if (t < 0 || dfa->trap[t] != DFA_TRAP_NONE) {
+                continue;
+            }
+            if (longest[s] > 0 && longest[s] + 1 > longest[t]) {
+                longest[t] = longest[s] + 1;
+                if (longest[t] > bound) {
+                    bound = longest[t];
+                }
+            }
+            if (--indegree[t] == 0) {
+                order[numOfOrdered++] = t;
+            }
         }
     }
-    int final = dfa->currentState;
-    return DFA_get_accepting(dfa, final);
+    free(indegree);
+    free(longest);
+    free(order);
+    return numOfOrdered == numOfUndecided ? bound : -1;
 }
 
-//problem 1a
-extern void problem_1_a() {
-    printf("Problem 1a (Only the string ab)--------------------------------------------\n");
-    printf("Only accepts 64 characters\n");
-    printf("Enter quit to exit the problem\n");
+//returns the state reached from s on byte b, where the dead state is
+//numOfStates (also for s)
+static inline int DFA_next_or_dead(const DFA* dfa, int s, int b){
+    int next = s < dfa->numOfStates ? dfa->stateArray[s].transition[b] : -1;
+    return next < 0 ? dfa->numOfStates : next;
+}
+
+//returns the index of the unordered pair of different states p and q
+static inline size_t DFA_pair_index(int p, int q){
+    if (p > q) {
+        int tmp = p;
+        p = q;
+        q = tmp;
+    }
+    return (size_t)q*(q - 1)/2 + p;
+}
+
+/**
+ * Return true if whether the given DFA accepts an input only depends on
+ * the input's last few bytes.
+ */
+extern bool DFA_is_definite(const DFA* dfa){
+    //a language is definite exactly when any two different states, fed the
+    //same bytes, end up in the same state after a bounded number of them,
+    //that is when the graph of pairs of different states (with the dead
+    //state as state n, if it can be reached) has no cycle; Kahn's
+    //algorithm finds whether it does
+    int n = dfa->numOfStates;
+    for (int s = 0; s < dfa->numOfStates && n == dfa->numOfStates; s++) {
+        for (int b = 0; b < DFA_NUM_SYMBOLS; b++) {
+            if (dfa->stateArray[s].transition[b] < 0) {
+                n++;
+                break;
+            }
+        }
+    }
+    int representative[256];
+    int numOfClasses = 0;
+    if (dfa->isFinalized) {
+        numOfClasses = dfa->numOfClasses;
+        for (int b = 0; b < 256; b++) {
+            representative[dfa->classMap[b]] = b;
+        }
+    } else {
+        for (int b = 0; b < 256; b++) {
+            representative[numOfClasses++] = b;
+        }
+    }
+    size_t numOfPairs = (size_t)n*(n - 1)/2;
+    int *indegree = (int *)calloc(numOfPairs + 1, sizeof(int));
+    int (*queue)[2] = malloc((numOfPairs + 1)*sizeof(*queue));
+    if (indegree == NULL || queue == NULL) {
+        abort();
+    }
+    for (int q = 1; q < n; q++) {
+        for (int p = 0; p < q; p++) {
+            for (int c = 0; c < numOfClasses; c++) {
+                int a = DFA_next_or_dead(dfa, p, representative[c]);
+                int b = DFA_next_or_dead(dfa, q, representative[c]);
+                if (a != b) {
+                    indegree[DFA_pair_index(a, b)]++;
+                }
+            }
+        }
+    }
+    size_t numOfQueued = 0;
+    for (int q = 1; q < n; q++) {
+        for (int p = 0; p < q; p++) {
+            if (indegree[DFA_pair_index(p, q)] == 0) {
+                queue[numOfQueued][0] = p;
+                queue[numOfQueued++][1] = q;
+            }
+        }
+    }
+    for (size_t i = 0; i < numOfQueued; i++) {
+        int p = queue[i][0];
+        int q = queue[i][1];
+        for (int c = 0; c < numOfClasses; c++) {
+            int a = DFA_next_or_dead(dfa, p, representative[c]);
+            int b = DFA_next_or_dead(dfa, q, representative[c]);
+            if (a != b && --indegree[DFA_pair_index(a, b)] == 0) {
+                queue[numOfQueued][0] = a < b ? a : b;
+                queue[numOfQueued++][1] = a < b ? b : a;
+            }
+        }
+    }
+    free(indegree);
+    free(queue);
+    return numOfQueued == numOfPairs;
+}
+
+/**
+ * Start the given cursor at the start state of the given DFA.
+ */
+extern void DFA_Cursor_init(DFA_Cursor *cursor, const DFA* dfa){
+    cursor->dfa = dfa;
+    cursor->state = dfa->numOfStates > 0 ? 0 : -1;
+}
+
+/**
+ * Advance the given cursor over the next len bytes of input.
+ */
+extern void DFA_Cursor_feed(DFA_Cursor *cursor, const unsigned char *input, size_t len){
+    cursor->state = DFA_step(cursor->dfa, cursor->state, input, len);
+}
+
+/**
+ * Return true if the input fed to the given cursor so far is accepted.
+ */
+extern bool DFA_Cursor_is_accepting(const DFA_Cursor *cursor){
+    return cursor->state != -1 && cursor->dfa->stateArray[cursor->state].isAccepting;
+}
+
+/**
+ * Return true if no further input can change whether the given cursor
+ * accepts.
+ */
+extern bool DFA_Cursor_is_decided(const DFA_Cursor *cursor){
+    const DFA *dfa = cursor->dfa;
+    return cursor->state == -1
+        || (dfa->isFinalized && dfa->trap[cursor->state] != DFA_TRAP_NONE);
+}
+
+//one loop over the finalized table per entry width that stops right after
+//the first byte taking it to an accepting row or the dead row (one unsigned
+//compare catches both); reads backwards from the end when asked. Each
+//updates the row offset at *id and returns how many bytes it read
+#define DFA_TABLE_SCAN(name, type)                                          \
+static size_t name(const DFA* dfa, size_t *id, const unsigned char *input, size_t len, \
+                   bool backwards){                                         \
+    const type *table = (const type *)dfa->table;                           \
+    const unsigned char *classMap = dfa->classMap;                          \
+    size_t stop = dfa->firstAccepting - 1;                                  \
+    size_t row = *id;                                                       \
+    size_t i = 0;                                                           \
+    if (backwards) {                                                        \
+        while (i < len) {                                                   \
+            row = table[row + classMap[input[len - 1 - i++]]];              \
+            if (row - 1 >= stop) {  /* 0 wraps around */                    \
+                break;                                                      \
+            }                                                               \
+        }                                                                   \
+    } else {                                                                \
+        while (i < len) {                                                   \
+            row = table[row + classMap[input[i++]]];                        \
+            if (row - 1 >= stop) {                                          \
+                break;                                                      \
+            }                                                               \
+        }                                                                   \
+    }                                                                       \
+    *id = row;                                                              \
+    return i;                                                               \
+}
+
+DFA_TABLE_SCAN(DFA_scan_table8, uint8_t)
+DFA_TABLE_SCAN(DFA_scan_table16, uint16_t)
+DFA_TABLE_SCAN(DFA_scan_table32, int32_t)
+
+/**
+ * Advance the given cursor over the len bytes at input until it accepts
+ * or gets stuck, and return how many bytes it read.
+ */
+extern size_t DFA_Cursor_feed_to_accept(DFA_Cursor *cursor, const unsigned char *input, size_t len,
+                                        bool backwards){
+    const DFA *dfa = cursor->dfa;
+    if (cursor->state < 0) {
+        return 0;
+    }
+    if (!dfa->isFinalized) {
+        int state = cursor->state;
+        size_t i = 0;
+        while (i < len) {
+            state = dfa->stateArray[state].transition[input[backwards ? len - 1 - i : i]];
+            i++;
+            if (state == -1 || dfa->stateArray[state].isAccepting) {
+                break;
+            }
+        }
+        cursor->state = state;
+        return i;
+    }
+    size_t id = dfa->rowOf[cursor->state];
+    size_t read;
+    if (dfa->stateBytes == 1) {
+        read = DFA_scan_table8(dfa, &id, input, len, backwards);
+    } else if (dfa->stateBytes == 2) {
+        read = DFA_scan_table16(dfa, &id, input, len, backwards);
+    } else {
+        read = DFA_scan_table32(dfa, &id, input, len, backwards);
+    }
+    cursor->state = DFA_row_state(dfa, id);
+    return read;
+}
+
+//number of inputs DFA_run_batch advances in lockstep, and the most steps
+//it takes before dropping lanes that have finished or died
+#define BATCH_WIDTH 8
+#define BATCH_STEPS 64
+
+/**
+ * Run the given DFA on count inputs, interleaving them so that their
+ * transition-table loads overlap, and set accepted[i] for each input.
+ */
+extern void DFA_run_batch(const DFA* dfa, const unsigned char *const *inputs,
+                          const size_t *lens, size_t count, bool *accepted){
+    if (!dfa->isFinalized) {
+        for (size_t i = 0; i < count; i++) {
+            accepted[i] = DFA_run(dfa, inputs[i], lens[i]);
+        }
+        return;
+    }
+    const unsigned char *classMap = dfa->classMap;
+    for (size_t group = 0; group < count; group += BATCH_WIDTH) {
+        //live lanes are compacted to the front of these arrays
+        const unsigned char *input[BATCH_WIDTH];
+        size_t remaining[BATCH_WIDTH];
+        size_t lane[BATCH_WIDTH];
+        size_t id[BATCH_WIDTH];     //row offsets, 0 once dead
+        int live = 0;
+        for (size_t i = group; i < count && i < group + BATCH_WIDTH; i++) {
+            input[live] = inputs[i];
+            remaining[live] = lens[i];
+            lane[live] = i;
+            id[live] = dfa->numOfStates > 0 ? dfa->rowOf[0] : 0;
+            live++;
+        }
+        while (live > 0) {
+            //every live lane can take this many steps without running out
+            size_t steps = BATCH_STEPS;
+            for (int l = 0; l < live; l++) {
+                if (remaining[l] < steps) {
+                    steps = remaining[l];
+                }
+            }
+            for (size_t t = 0; t < steps; t++) {
+                for (int l = 0; l < live; l++) {
+                    id[l] = DFA_table_entry(dfa, id[l], classMap[input[l][t]]);
+                }
+            }
+            int kept = 0;
+            for (int l = 0; l < live; l++) {
+                input[l] += steps;
+                remaining[l] -= steps;
+                if (remaining[l] == 0 || id[l] - 1 >= dfa->firstTrapped - 1) {
+                    accepted[lane[l]] = id[l] >= dfa->firstAccepting;
+                } else {
+                    input[kept] = input[l];
+                    remaining[kept] = remaining[l];
+                    lane[kept] = lane[l];
+                    id[kept] = id[l];
+                    kept++;
+                }
+            }
+            live = kept;
+        }
+    }
+}
+
+//builds the automaton for problem 1a
+extern DFA* problem_1_a_dfa() {
     DFA* problem1a = DFA_new(3);
     DFA_set_transition(problem1a, 0, 'a', 1);
     DFA_set_transition(problem1a, 1, 'b', 2);
     DFA_set_accepting(problem1a, 2, true);
+    return problem1a;
+}
+
+//problem 1a
+extern void problem_1_a() {
+    printf("Problem 1a (Only the string ab)--------------------------------------------\n");
+    printf("Enter quit to exit the problem\n");
+    DFA* problem1a = problem_1_a_dfa();
+    DFA_finalize(problem1a);
 
 //while loop keeps making user enter input until they type quit
+    char *input = NULL;
+    size_t capacity = 0;
     while (1) {
-        DFA_set_current_state(problem1a, 0);
-        char *input = malloc(64*sizeof(char));
         printf("Test: ");
-        scanf("%s", input);
+        ssize_t len = getline(&input, &capacity, stdin);
+        if (len > 0 && input[len-1] == '\n') {
+            input[--len] = '\0';
+        }
 
-        if (strncmp(input, "quit", 4) == 0) {
+        if (len < 0 || strncmp(input, "quit", 4) == 0) {
             printf("Quitting Problem 1a\n");
             break;
         }
 
-        int test = DFA_execute(problem1a, input);
+        int test = DFA_run(problem1a, (unsigned char *)input, len);
         if (test == 0) {
             printf("%s is not accepted\n", input);
         }
@@ -175,33 +1026,43 @@ extern void problem_1_a() {
             printf("%s is accepted\n", input);
         }
     }
+    free(input);
     printf("\n");
     DFA_free(problem1a);
 }
-//problem 1b
-extern void problem_1_b() {
-    printf("Problem 1b (Begins with ab)--------------------------------------------\n");
-    printf("Only accepts 64 characters\n");
-    printf("Enter quit to exit the problem\n");
+//builds the automaton for problem 1b
+extern DFA* problem_1_b_dfa() {
     DFA* problem1b = DFA_new(3);
     DFA_set_transition(problem1b, 0, 'a', 1);
     DFA_set_transition(problem1b, 1, 'b', 2);
     DFA_set_transition_all(problem1b, 2, 2);
     DFA_set_accepting(problem1b, 2, true);
+    return problem1b;
+}
+
+//problem 1b
+extern void problem_1_b() {
+    printf("Problem 1b (Begins with ab)--------------------------------------------\n");
+    printf("Enter quit to exit the problem\n");
+    DFA* problem1b = problem_1_b_dfa();
+    DFA_finalize(problem1b);
 
 //while loop keeps making user enter input until they type quit
+    char *input = NULL;
+    size_t capacity = 0;
     while (1) {
-        DFA_set_current_state(problem1b, 0);
-        char *input = malloc(64*sizeof(char));
         printf("Test: ");
-        scanf("%s", input);
+        ssize_t len = getline(&input, &capacity, stdin);
+        if (len > 0 && input[len-1] == '\n') {
+            input[--len] = '\0';
+        }
 
-        if (strncmp(input, "quit", 4) == 0) {
+        if (len < 0 || strncmp(input, "quit", 4) == 0) {
             printf("Quitting Problem 1b\n");
             break;
         }
 
-        int test = DFA_execute(problem1b, input);
+        int test = DFA_run(problem1b, (unsigned char *)input, len);
         if (test == 0) {
             printf("%s is not accepted\n", input);
         }
@@ -209,14 +1070,12 @@ extern void problem_1_b() {
             printf("%s is accepted\n", input);
         }
     }
+    free(input);
     printf("\n");
     DFA_free(problem1b);
 }
-//problem 1c
-extern void problem_1_c() {
-    printf("Problem 1c (Binary Input with Even Number of 1's)--------------------------------------------\n");
-    printf("Only accepts 64 characters\n");
-    printf("Enter quit to exit the problem\n");
+//builds the automaton for problem 1c
+extern DFA* problem_1_c_dfa() {
     DFA* problem1c = DFA_new(2);
     DFA_set_transition(problem1c, 0, '0', 0);
     DFA_set_transition(problem1c, 0, '1', 1);
@@ -224,20 +1083,32 @@ extern void problem_1_c() {
     DFA_set_transition(problem1c, 1, '0', 1);
 
     DFA_set_accepting(problem1c, 0, true);
+    return problem1c;
+}
+
+//problem 1c
+extern void problem_1_c() {
+    printf("Problem 1c (Binary Input with Even Number of 1's)--------------------------------------------\n");
+    printf("Enter quit to exit the problem\n");
+    DFA* problem1c = problem_1_c_dfa();
+    DFA_finalize(problem1c);
 
 //while loop keeps making user enter input until they type quit
+    char *input = NULL;
+    size_t capacity = 0;
     while (1) {
-        DFA_set_current_state(problem1c, 0);
-        char *input = malloc(64*sizeof(char));
         printf("Test: ");
-        scanf("%s", input);
+        ssize_t len = getline(&input, &capacity, stdin);
+        if (len > 0 && input[len-1] == '\n') {
+            input[--len] = '\0';
+        }
 
-        if (strncmp(input, "quit", 4) == 0) {
+        if (len < 0 || strncmp(input, "quit", 4) == 0) {
             printf("Quitting Problem 1b\n");
             break;
         }
 
-        int test = DFA_execute(problem1c, input);
+        int test = DFA_run(problem1c, (unsigned char *)input, len);
         if (test == 0) {
             printf("%s is not accepted\n", input);
         }
@@ -245,15 +1116,13 @@ extern void problem_1_c() {
             printf("%s is accepted\n", input);
         }
     }
+    free(input);
     printf("\n");
     DFA_free(problem1c);
 }
 
-//problem 1d
-extern void problem_1_d(){
-    printf("Problem 1d (Binary Input with Even Number of 1's and 0's)--------------------------------------------\n");
-    printf("Only accepts 64 characters\n");
-    printf("Enter quit to exit the problem\n");
+//builds the automaton for problem 1d
+extern DFA* problem_1_d_dfa() {
     DFA* problem1d = DFA_new(4);
     DFA_set_transition(problem1d, 0, '0', 1);
     DFA_set_transition(problem1d, 3, '1', 0);
@@ -265,20 +1134,32 @@ extern void problem_1_d(){
     DFA_set_transition(problem1d, 1, '0', 0);
 
     DFA_set_accepting(problem1d, 0 , true);
+    return problem1d;
+}
+
+//problem 1d
+extern void problem_1_d(){
+    printf("Problem 1d (Binary Input with Even Number of 1's and 0's)--------------------------------------------\n");
+    printf("Enter quit to exit the problem\n");
+    DFA* problem1d = problem_1_d_dfa();
+    DFA_finalize(problem1d);
 
 //while loop keeps making user enter input until they type quit
+    char *input = NULL;
+    size_t capacity = 0;
     while (1) {
-        DFA_set_current_state(problem1d, 0);
-        char *input = malloc(64*sizeof(char));
         printf("Test: ");
-        scanf("%s", input);
+        ssize_t len = getline(&input, &capacity, stdin);
+        if (len > 0 && input[len-1] == '\n') {
+            input[--len] = '\0';
+        }
 
-        if (strncmp(input, "quit", 4) == 0) {
+        if (len < 0 || strncmp(input, "quit", 4) == 0) {
             printf("Quitting Problem 1b\n");
             break;
         }
 
-        int test = DFA_execute(problem1d, input);
+        int test = DFA_run(problem1d, (unsigned char *)input, len);
         if (test == 0) {
             printf("%s is not accepted\n", input);
         }
@@ -286,16 +1167,13 @@ extern void problem_1_d(){
             printf("%s is accepted\n", input);
         }
     }
+    free(input);
     printf("\n");
     DFA_free(problem1d);
 
 }
-//problem 1e
-extern void problem_1_e(){
-    printf("Problem 1e (Binary Input with Odd Number of 1's AND 0's)--------------------------------------------\n");
-    printf("Only accepts 64 characters\n");
-    printf("Enter quit to exit the problem\n");
-
+//builds the automaton for problem 1e
+extern DFA* problem_1_e_dfa() {
     DFA* problem1e = DFA_new(4);
     DFA_set_transition(problem1e, 0, '0', 1);
     DFA_set_transition(problem1e, 3, '1', 0);
@@ -307,20 +1185,33 @@ extern void problem_1_e(){
     DFA_set_transition(problem1e, 1, '0', 0);
 
     DFA_set_accepting(problem1e, 2, true);
+    return problem1e;
+}
+
+//problem 1e
+extern void problem_1_e(){
+    printf("Problem 1e (Binary Input with Odd Number of 1's AND 0's)--------------------------------------------\n");
+    printf("Enter quit to exit the problem\n");
+
+    DFA* problem1e = problem_1_e_dfa();
+    DFA_finalize(problem1e);
 
 //while loop keeps making user enter input until they type quit
+    char *input = NULL;
+    size_t capacity = 0;
     while (1) {
-        DFA_set_current_state(problem1e, 0);
-        char *input = malloc(64*sizeof(char));
         printf("Test: ");
-        scanf("%s", input);
+        ssize_t len = getline(&input, &capacity, stdin);
+        if (len > 0 && input[len-1] == '\n') {
+            input[--len] = '\0';
+        }
 
-        if (strncmp(input, "quit", 4) == 0) {
+        if (len < 0 || strncmp(input, "quit", 4) == 0) {
             printf("Quitting Problem 1e\n");
             break;
         }
 
-        int test = DFA_execute(problem1e, input);
+        int test = DFA_run(problem1e, (unsigned char *)input, len);
         if (test == 0) {
             printf("%s is not accepted\n", input);
         }
@@ -328,8 +1219,7 @@ extern void problem_1_e(){
             printf("%s is accepted\n", input);
         }
     }
+    free(input);
     printf("\n");
     DFA_free(problem1e);
 }
-
-#endif
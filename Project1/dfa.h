@@ -15,6 +15,7 @@
 #define _dfa_h
 
 #include <stdbool.h>
+#include <stddef.h>
 
 /**
  * The data structure used to represent a deterministic finite automaton.
@@ -23,12 +24,17 @@
  * (encapsulate) its implementation behind the declared API functions and
  * only provide a partial declaration in the header file.
  */
-typedef struct DFA *DFA;
+typedef struct DFA DFA;
+
+/**
+ * The number of input symbols: DFAs run over arbitrary bytes.
+ */
+#define DFA_NUM_SYMBOLS 256
 
 /**
  * Allocate and return a new DFA containing the given number of states.
  */
-extern DFA DFA_new(int nstates);
+extern DFA* DFA_new(int nstates);
 
 /**
  * Free the given DFA.
@@ -38,7 +44,7 @@ extern void DFA_free(DFA* dfa);
 /**
  * Return the number of states in the given DFA.
  */
-extern int DFA_get_size(DFA* dfa);
+extern int DFA_get_size(const DFA* dfa);
 
 /**
  * Return the state specified by the given DFA's transition function from
@@ -77,11 +83,53 @@ extern void DFA_set_accepting(DFA* dfa, int state, bool value);
  */
 extern bool DFA_get_accepting(DFA* dfa, int state);
 
+/**
+ * Set the tag of the given DFA's state: an arbitrary int that callers can
+ * use to tell accepting states apart, say by which pattern they accept.
+ * Runs only stop early where neither acceptance nor the tag can change any
+ * more, and DFA_minimize only merges states with equal tags. States
+ * without a tag, and getting stuck, count as tag 0.
+ */
+extern void DFA_set_tag(DFA* dfa, int state, int tag);
+
+/**
+ * Return the tag of the given DFA's state.
+ */
+extern int DFA_get_tag(const DFA* dfa, int state);
+
+/**
+ * Build the compact transition table that DFA_execute runs on: input
+ * bytes whose transitions agree in every state are grouped into classes,
+ * and each state stores one successor per class instead of one per byte.
+ * DFA_execute calls this itself if the DFA changed since the last call.
+ */
+extern void DFA_finalize(DFA* dfa);
+
+/**
+ * Return the number of input byte classes of the given DFA (finalizing
+ * it if necessary).
+ */
+extern int DFA_get_num_classes(DFA* dfa);
+
+/**
+ * Choose whether a finalized DFA with fewer than 16 states runs on the
+ * vector shuffle kernel (the default) or walks the transition table.
+ * Results are the same either way.
+ */
+extern void DFA_set_shuffle_kernel(DFA* dfa, bool enabled);
+
 /**
  * Run the given DFA on the given input string, and return true if it accepts
  * the input, otherwise false.
  */
 
+//builds the DFAs used by the problems below
+extern DFA* problem_1_a_dfa();
+extern DFA* problem_1_b_dfa();
+extern DFA* problem_1_c_dfa();
+extern DFA* problem_1_d_dfa();
+extern DFA* problem_1_e_dfa();
+
 extern void problem_1_a();
 
 extern void problem_1_b();
@@ -97,4 +145,95 @@ extern void problem_2_a();
 //executes the automata
 extern bool DFA_execute(DFA* dfa, char *input);
 
+/**
+ * Run the given DFA from its start state on the len bytes at input (any
+ * byte values, including '\0'), and return true if it accepts them.
+ * Unlike DFA_execute this does not modify the DFA, so once DFA_finalize
+ * has been called one DFA can be shared by any number of threads.
+ */
+extern bool DFA_run(const DFA* dfa, const unsigned char *input, size_t len);
+
+/**
+ * Like DFA_run, but read the len bytes at input from input[len-1] down to
+ * input[0]. Run on DFA_reverse of a DFA (see nfatodfa.h) this decides
+ * whether that DFA accepts the input, and for patterns that only look at
+ * the end of the input (like "ends in man") it stops after the few bytes
+ * that matter, as soon as the outcome is decided.
+ */
+extern bool DFA_run_backwards(const DFA* dfa, const unsigned char *input, size_t len);
+
+/**
+ * Return the most bytes a run of the given finalized DFA can read before
+ * the outcome is decided (see DFA_Cursor_is_decided), or -1 if a run can
+ * stay undecided forever (or the DFA is not finalized). For example, the
+ * reverse of "ends in man" gives 3 and "ends in man" itself gives -1.
+ */
+extern int DFA_get_decision_bound(const DFA* dfa);
+
+/**
+ * Return true if the language of the given DFA is definite: whether an
+ * input is accepted only depends on its last k bytes, for some k (and on
+ * the whole input when it is shorter), like "ends in man" with k = 3.
+ * These are exactly the DFAs whose reverse (see DFA_reverse) is always
+ * decided after k bytes, so they can be run backwards in O(k) time. Takes
+ * time quadratic in the number of states. The DFA should be minimal, with
+ * every state reachable.
+ */
+extern bool DFA_is_definite(const DFA* dfa);
+
+/**
+ * A position in a run of a DFA, for feeding it input a piece at a time.
+ * It is a plain struct so that it can live on the caller's stack; the
+ * DFA itself is only read.
+ */
+typedef struct {
+    const DFA *dfa;
+    int state;   //current state, or -1 once no input can be accepted; once
+                 //every reachable state accepts with its tag it stops
+                 //changing
+} DFA_Cursor;
+
+/**
+ * Start the given cursor at the start state of the given DFA.
+ */
+extern void DFA_Cursor_init(DFA_Cursor *cursor, const DFA* dfa);
+
+/**
+ * Advance the given cursor over the next len bytes of input.
+ */
+extern void DFA_Cursor_feed(DFA_Cursor *cursor, const unsigned char *input, size_t len);
+
+/**
+ * Return true if the input fed to the given cursor so far is accepted.
+ */
+extern bool DFA_Cursor_is_accepting(const DFA_Cursor *cursor);
+
+/**
+ * Return true if no further input can change whether the given cursor
+ * accepts: it is stuck, or every state it can still reach is accepting.
+ * Only known for finalized DFAs.
+ */
+extern bool DFA_Cursor_is_decided(const DFA_Cursor *cursor);
+
+/**
+ * Advance the given cursor over the len bytes at input, one at a time,
+ * and stop right after the first byte that leaves it accepting or stuck
+ * (or at the end). Returns how many bytes it read. With backwards set it
+ * reads them from input[len-1] down to input[0] instead, for running a
+ * reversed DFA. Finding where matches end comes down to repeating this.
+ */
+extern size_t DFA_Cursor_feed_to_accept(DFA_Cursor *cursor, const unsigned char *input, size_t len,
+                                        bool backwards);
+
+/**
+ * Run the given DFA from its start state on each of count inputs (input i
+ * is the lens[i] bytes at inputs[i]) and set accepted[i] to whether it
+ * accepts. Several inputs are advanced in lockstep so that the CPU can
+ * overlap their transition-table lookups, which makes this much faster
+ * than count calls to DFA_run for many short inputs. Like DFA_run it only
+ * reads the DFA; it runs on the compact table once DFA_finalize is called.
+ */
+extern void DFA_run_batch(const DFA* dfa, const unsigned char *const *inputs,
+                          const size_t *lens, size_t count, bool *accepted);
+
 #endif
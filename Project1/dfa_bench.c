@@ -0,0 +1,84 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: dfa_bench.c
+ *
+ * Times DFA_run with the vector shuffle kernel against the plain
+ * transition-table walk on a few small DFAs, and checks that both give
+ * the same answer. Build and run with "make bench".
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "dfa.h"
+
+#define BENCH_BYTES (16 << 20)
+#define BENCH_REPEATS 5
+
+//a DFA with n states counting occurrences of 'x' modulo n
+static DFA* counter_dfa(int n) {
+    DFA* dfa = DFA_new(n);
+    for (int s = 0; s < n; s++) {
+        DFA_set_transition_all(dfa, s, s);
+        DFA_set_transition(dfa, s, 'x', (s + 1) % n);
+    }
+    DFA_set_accepting(dfa, 0, true);
+    return dfa;
+}
+
+//returns the best of BENCH_REPEATS runs in nanoseconds per byte
+static double time_run(DFA* dfa, const unsigned char *input, size_t len, bool *result) {
+    double best = -1;
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        clock_t start = clock();
+        *result = DFA_run(dfa, input, len);
+        double ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / len;
+        if (best < 0 || ns < best) {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+static int bench(const char *name, DFA* dfa, const unsigned char *input, size_t len) {
+    bool table_result, shuffle_result;
+    DFA_finalize(dfa);
+    DFA_set_shuffle_kernel(dfa, false);
+    double table_ns = time_run(dfa, input, len, &table_result);
+    DFA_set_shuffle_kernel(dfa, true);
+    double shuffle_ns = time_run(dfa, input, len, &shuffle_result);
+    printf("%-12s table %.3f ns/byte  shuffle %.3f ns/byte  %s\n", name, table_ns, shuffle_ns,
+           table_result == shuffle_result ? "ok" : "MISMATCH");
+    DFA_free(dfa);
+    return table_result == shuffle_result ? 0 : 1;
+}
+
+int
+main(int argc, char **argv) {
+    unsigned char *input = malloc(BENCH_BYTES);
+    if (input == NULL) {
+        return 1;
+    }
+    int failures = 0;
+
+    srand(173);
+    for (size_t i = 0; i < BENCH_BYTES; i++) {
+        input[i] = rand() % 2 ? '1' : '0';
+    }
+    failures += bench("problem 1c", problem_1_c_dfa(), input, BENCH_BYTES);
+    failures += bench("problem 1d", problem_1_d_dfa(), input, BENCH_BYTES);
+
+    for (size_t i = 0; i < BENCH_BYTES; i++) {
+        input[i] = rand() % 4 ? (unsigned char)rand() : 'x';
+    }
+    failures += bench("counter 7", counter_dfa(7), input, BENCH_BYTES);
+    failures += bench("counter 15", counter_dfa(15), input, BENCH_BYTES);
+
+    free(input);
+    return failures;
+}
@@ -0,0 +1,216 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: dfa_test.c
+ *
+ * Test program for the trap states finalizing a DFA finds: runs and
+ * cursors that are decided once they reach one, for DFAs and for NFAs,
+ * and tagged states that are not traps.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "dfa.h"
+#include "nfa.h"
+#include "nfatodfa.h"
+#include "test_util.h"
+
+//feeds the given string to a cursor on the given DFA a byte at a time,
+//and checks whether it is decided and accepting after each prefix, where
+//decided has a 'd' for each decided prefix (from the empty one) and a '-'
+//otherwise, and accepting likewise has an 'a' or a '-'
+static void check_cursor(DFA* dfa, const char *input, const char *decided,
+                         const char *accepting) {
+    DFA_Cursor cursor;
+    DFA_Cursor_init(&cursor, dfa);
+    size_t len = strlen(input);
+    char gotDecided[64];
+    char gotAccepting[64];
+    for (size_t i = 0; i <= len; i++) {
+        if (i > 0) {
+            DFA_Cursor_feed(&cursor, (const unsigned char *)input + i - 1, 1);
+        }
+        gotDecided[i] = DFA_Cursor_is_decided(&cursor) ? 'd' : '-';
+        gotAccepting[i] = DFA_Cursor_is_accepting(&cursor) ? 'a' : '-';
+    }
+    gotDecided[len + 1] = '\0';
+    gotAccepting[len + 1] = '\0';
+    printf("cursor on \"%s\" decided %s accepting %s\n", input, gotDecided, gotAccepting);
+    if (strcmp(gotDecided, decided) != 0 || strcmp(gotAccepting, accepting) != 0) {
+        printf("  FAILED: expected decided %s accepting %s\n", decided, accepting);
+        test_failures++;
+    }
+}
+
+//the same for a cursor on the given NFA, where decided also marks dead
+//prefixes with an 'x'
+static void check_nfa_cursor(NFA* nfa, const char *input, const char *decided,
+                             const char *accepting) {
+    NFA_Cursor *cursor = NFA_Cursor_new(nfa);
+    size_t len = strlen(input);
+    char gotDecided[64];
+    char gotAccepting[64];
+    for (size_t i = 0; i <= len; i++) {
+        if (i > 0) {
+            NFA_Cursor_feed(cursor, (const unsigned char *)input + i - 1, 1);
+        }
+        gotDecided[i] = NFA_Cursor_is_dead(cursor) ? 'x'
+            : NFA_Cursor_is_decided(cursor) ? 'd' : '-';
+        gotAccepting[i] = NFA_Cursor_is_accepting(cursor) ? 'a' : '-';
+    }
+    gotDecided[len + 1] = '\0';
+    gotAccepting[len + 1] = '\0';
+    printf("NFA cursor on \"%s\" decided %s accepting %s\n", input, gotDecided, gotAccepting);
+    if (strcmp(gotDecided, decided) != 0 || strcmp(gotAccepting, accepting) != 0) {
+        printf("  FAILED: expected decided %s accepting %s\n", decided, accepting);
+        test_failures++;
+    }
+    NFA_Cursor_free(cursor);
+}
+
+//checks the given DFA on the given prefix followed by a long tail of
+//0xff bytes, with DFA_run, a cursor and DFA_run_batch, with and without
+//the shuffle kernel
+static void check_tail(DFA* dfa, const char *prefix, bool expected) {
+    size_t len = strlen(prefix) + 1000;
+    unsigned char *input = (unsigned char*)malloc(len);
+    if (input == NULL) {
+        abort();
+    }
+    memset(input, 0xff, len);
+    memcpy(input, prefix, strlen(prefix));
+    for (int shuffle = 0; shuffle < 2; shuffle++) {
+        DFA_set_shuffle_kernel(dfa, shuffle);
+        char what[128];
+        snprintf(what, sizeof(what), "\"%s\" and a tail accepted (shuffle %d)", prefix, shuffle);
+        check(what, DFA_run(dfa, input, len), expected);
+        DFA_Cursor cursor;
+        DFA_Cursor_init(&cursor, dfa);
+        DFA_Cursor_feed(&cursor, input, len);
+        if (DFA_Cursor_is_accepting(&cursor) != expected) {
+            printf("  FAILED: the cursor disagrees\n");
+            test_failures++;
+        }
+        const unsigned char *inputs[1] = { input };
+        bool accepted = !expected;
+        DFA_run_batch(dfa, inputs, &len, 1, &accepted);
+        if (accepted != expected) {
+            printf("  FAILED: DFA_run_batch disagrees\n");
+            test_failures++;
+        }
+    }
+    DFA_set_shuffle_kernel(dfa, true);
+    free(input);
+}
+
+int
+main(int argc, char **argv) {
+    printf("problem 1b: beginning with ab\n");
+    DFA *dfa = problem_1_b_dfa();
+    check_cursor(dfa, "abc", "----", "--aa");
+    check_cursor(dfa, "ba", "-dd", "---");
+    DFA_finalize(dfa);
+    check("decision bound", DFA_get_decision_bound(dfa), 2);
+    check_cursor(dfa, "abc", "--dd", "--aa");
+    check_cursor(dfa, "ba", "-dd", "---");
+    check_tail(dfa, "ab", true);
+    check_tail(dfa, "a", false);
+    DFA_free(dfa);
+
+    printf("problem 1a: only ab\n");
+    dfa = problem_1_a_dfa();
+    DFA_finalize(dfa);
+    check("decision bound", DFA_get_decision_bound(dfa), 3);
+    check_cursor(dfa, "abb", "---d", "--a-");
+    DFA_free(dfa);
+
+    printf("problem 2c: code anywhere\n");
+    NFA *nfa = problem_2_c_nfa();
+    dfa = nfa_to_dfa(nfa);
+    DFA_finalize(dfa);
+    check("decision bound", DFA_get_decision_bound(dfa), -1);
+    check_cursor(dfa, "xcodex", "-----dd", "-----aa");
+    check_cursor(dfa, "cocode", "------d", "------a");
+    check_tail(dfa, "xxcode", true);
+    check_tail(dfa, "xxcod", false);
+    for (int backend = 0; backend < 3; backend++) {
+        NFA_set_backend(nfa, (NFA_BACKEND)backend);
+        check_nfa_cursor(nfa, "xcodex", "-----dd", "-----aa");
+    }
+    DFA_free(dfa);
+    NFA_free(nfa);
+
+    printf("problem 2a: ending in man\n");
+    nfa = problem_2_a_nfa();
+    dfa = nfa_to_dfa(nfa);
+    DFA_finalize(dfa);
+    check_cursor(dfa, "manx", "-----", "---a-");
+    for (int backend = 0; backend < 3; backend++) {
+        NFA_set_backend(nfa, (NFA_BACKEND)backend);
+        check_nfa_cursor(nfa, "manx", "-----", "---a-");
+    }
+    DFA_free(dfa);
+    NFA_free(nfa);
+
+    printf("ab only, with a state for everything else\n");
+    dfa = DFA_new(4);
+    DFA_set_transition_all(dfa, 0, 3);
+    DFA_set_transition_all(dfa, 1, 3);
+    DFA_set_transition_all(dfa, 2, 3);
+    DFA_set_transition_all(dfa, 3, 3);
+    DFA_set_transition(dfa, 0, 'a', 1);
+    DFA_set_transition(dfa, 1, 'b', 2);
+    DFA_set_accepting(dfa, 2, true);
+    check_cursor(dfa, "abb", "----", "--a-");
+    DFA_finalize(dfa);
+    check("decision bound", DFA_get_decision_bound(dfa), 3);
+    check_cursor(dfa, "abb", "---d", "--a-");
+    check_cursor(dfa, "b", "-d", "--");
+    check_tail(dfa, "ab", false);
+    DFA_free(dfa);
+
+    printf("an NFA for ab only\n");
+    nfa = NFA_new(4);
+    NFA_add_transition(nfa, 0, 'a', 1);
+    NFA_add_transition(nfa, 1, 'b', 2);
+    NFA_set_accepting(nfa, 2, true);
+    for (int backend = 0; backend < 3; backend++) {
+        NFA_set_backend(nfa, (NFA_BACKEND)backend);
+        check_nfa_cursor(nfa, "abb", "---x", "--a-");
+    }
+    //a state that can never accept still keeps the cursor from being dead
+    NFA_add_transition(nfa, 2, 'b', 3);
+    check_nfa_cursor(nfa, "abbb", "----x", "--a--");
+    NFA_free(nfa);
+
+    printf("tagged states\n");
+    //0 -a-> 1 and 0 -c-> 3; 1 accepts with tag 1 and loops on every byte
+    //but b, which goes to 2, which accepts with tag 2 and loops on every
+    //byte; 3 does not accept but has tag 3 and gets stuck
+    dfa = DFA_new(4);
+    DFA_set_transition(dfa, 0, 'a', 1);
+    DFA_set_transition(dfa, 0, 'c', 3);
+    DFA_set_transition_all(dfa, 1, 1);
+    DFA_set_transition(dfa, 1, 'b', 2);
+    DFA_set_transition_all(dfa, 2, 2);
+    DFA_set_accepting(dfa, 1, true);
+    DFA_set_accepting(dfa, 2, true);
+    DFA_set_tag(dfa, 1, 1);
+    DFA_set_tag(dfa, 2, 2);
+    DFA_set_tag(dfa, 3, 3);
+    DFA_finalize(dfa);
+    check_cursor(dfa, "aab", "---d", "-aaa");
+    check_cursor(dfa, "cc", "--d", "---");
+    check_tail(dfa, "ab", true);
+    check_tail(dfa, "aa", true);
+    check_tail(dfa, "c", false);
+    DFA_free(dfa);
+
+    return test_summary();
+}
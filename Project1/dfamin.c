@@ -0,0 +1,325 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: dfamin.c
+ *
+ * Hopcroft's algorithm. The reachable states plus an explicit dead state
+ * are kept in one array, elems[], in which every block of the partition
+ * is a contiguous range; states found to have a transition into the
+ * current splitter are swapped to the front of their block, and a block
+ * with some but not all of its states marked is split in two.
+ * Input symbols with identical columns are refined together.
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dfamin.h"
+
+typedef struct { //the partition of states into blocks
+    int *elems;     //states, grouped by block
+    int *loc;       //position of each state in elems
+    int *block;     //block of each state
+    int *first;     //range of each block in elems is [first, end)
+    int *end;
+    int *marked;    //number of marked states at the front of each block
+    int numOfBlocks;
+} PARTITION;
+
+static void *DFA_min_alloc(size_t count, size_t size) {
+    void *ptr = calloc(count > 0 ? count : 1, size);
+    if (ptr == NULL) {
+        abort();
+    }
+    return ptr;
+}
+
+typedef struct { //what the initial partition groups states by
+    int state;
+    bool accepting;
+    int tag;
+} DFA_MIN_KEY;
+
+//orders keys by acceptance and then by tag, for qsort
+static int DFA_min_compare_keys(const void *a, const void *b) {
+    const DFA_MIN_KEY *x = (const DFA_MIN_KEY *)a;
+    const DFA_MIN_KEY *y = (const DFA_MIN_KEY *)b;
+    if (x->accepting != y->accepting) {
+        return x->accepting ? -1 : 1;
+    }
+    return x->tag < y->tag ? -1 : x->tag > y->tag;
+}
+
+//moves state s to the marked front of its block; returns true if it is
+//the first state marked in the block
+static bool PARTITION_mark(PARTITION *p, int s) {
+    int b = p->block[s];
+    int pos = p->loc[s];
+    int front = p->first[b] + p->marked[b];
+    if (pos < front) {
+        return false; //already marked
+    }
+    int other = p->elems[front];
+    p->elems[front] = s;
+    p->loc[s] = front;
+    p->elems[pos] = other;
+    p->loc[other] = pos;
+    return p->marked[b]++ == 0;
+}
+
+/**
+ * Build and return the minimal DFA accepting the same language as the
+ * given DFA.
+ */
+extern DFA* DFA_minimize(DFA* dfa, int **mapping) {
+    int n = DFA_get_size(dfa);
+    int dead = n; //extra state standing for every missing transition
+
+    //keep only the states reachable from 0
+    bool *reachable = (bool *)DFA_min_alloc(n + 1, sizeof(bool));
+    int *queue = (int *)DFA_min_alloc(n + 1, sizeof(int));
+    int numOfReachable = 0;
+    if (n > 0) {
+        reachable[0] = true;
+        queue[numOfReachable++] = 0;
+    }
+    for (int head = 0; head < numOfReachable; head++) {
+        for (int sym = 0; sym < DFA_NUM_SYMBOLS; sym++) {
+            int dst = DFA_get_transition(dfa, queue[head], sym);
+            if (dst >= 0 && !reachable[dst]) {
+                reachable[dst] = true;
+                queue[numOfReachable++] = dst;
+            }
+        }
+    }
+    reachable[dead] = true;
+    queue[numOfReachable++] = dead;
+
+    //group symbols whose columns agree on every reachable state
+    int classOf[DFA_NUM_SYMBOLS];
+    int representative[DFA_NUM_SYMBOLS];
+    int numOfClasses = 0;
+    for (int sym = 0; sym < DFA_NUM_SYMBOLS; sym++) {
+        classOf[sym] = -1;
+        for (int c = 0; c < numOfClasses && classOf[sym] < 0; c++) {
+            bool same = true;
+            for (int i = 0; i < numOfReachable - 1 && same; i++) {
+                same = DFA_get_transition(dfa, queue[i], sym)
+                       == DFA_get_transition(dfa, queue[i], representative[c]);
+            }
+            if (same) {
+                classOf[sym] = c;
+            }
+        }
+        if (classOf[sym] < 0) {
+            representative[numOfClasses] = sym;
+            classOf[sym] = numOfClasses++;
+        }
+    }
+    int k = numOfClasses;
+
+    //successor of each state on each class, with the dead state explicit
+    int *delta = (int *)DFA_min_alloc((size_t)(n + 1) * k, sizeof(int));
+    for (int s = 0; s <= n; s++) {
+        for (int c = 0; c < k; c++) {
+            int dst = s == dead || !reachable[s] ? -1
+                      : DFA_get_transition(dfa, s, representative[c]);
+            delta[s*k + c] = dst < 0 ? dead : dst;
+        }
+    }
+
+    //predecessors on each class, as ranges predStart[t*k+c].. into preds
+    int *predStart = (int *)DFA_min_alloc((size_t)(n + 1) * k + 1, sizeof(int));
+    int *preds = (int *)DFA_min_alloc((size_t)numOfReachable * k, sizeof(int));
+    for (int i = 0; i < numOfReachable; i++) {
+        for (int c = 0; c < k; c++) {
+            predStart[delta[queue[i]*k + c]*k + c + 1]++;
+        }
+    }
+    for (int i = 0; i < (n + 1) * k; i++) {
+        predStart[i + 1] += predStart[i];
+    }
+    int *fill = (int *)DFA_min_alloc((size_t)(n + 1) * k, sizeof(int));
+    memcpy(fill, predStart, (size_t)(n + 1) * k * sizeof(int));
+    for (int i = 0; i < numOfReachable; i++) {
+        for (int c = 0; c < k; c++) {
+            int t = delta[queue[i]*k + c];
+            preds[fill[t*k + c]++] = queue[i];
+        }
+    }
+    free(fill);
+
+    //initial partition: one block per combination of acceptance and tag,
+    //with the dead state in the block of rejecting states with tag 0
+    PARTITION p;
+    p.elems = (int *)DFA_min_alloc(numOfReachable, sizeof(int));
+    p.loc = (int *)DFA_min_alloc(n + 1, sizeof(int));
+    p.block = (int *)DFA_min_alloc(n + 1, sizeof(int));
+    p.first = (int *)DFA_min_alloc(numOfReachable, sizeof(int));
+    p.end = (int *)DFA_min_alloc(numOfReachable, sizeof(int));
+    p.marked = (int *)DFA_min_alloc(numOfReachable, sizeof(int));
+    DFA_MIN_KEY *keys = (DFA_MIN_KEY *)DFA_min_alloc(numOfReachable, sizeof(DFA_MIN_KEY));
+    for (int i = 0; i < numOfReachable; i++) {
+        int s = queue[i];
+        keys[i].state = s;
+        keys[i].accepting = s != dead && DFA_get_accepting(dfa, s);
+        keys[i].tag = s != dead ? DFA_get_tag(dfa, s) : 0;
+    }
+    qsort(keys, numOfReachable, sizeof(DFA_MIN_KEY), DFA_min_compare_keys);
+    p.numOfBlocks = 0;
+    for (int i = 0; i < numOfReachable; i++) {
+        if (i == 0 || DFA_min_compare_keys(&keys[i - 1], &keys[i]) != 0) {
+            if (i > 0) {
+                p.end[p.numOfBlocks - 1] = i;
+            }
+            p.first[p.numOfBlocks++] = i;
+        }
+        p.elems[i] = keys[i].state;
+    }
+    p.end[p.numOfBlocks - 1] = numOfReachable;
+    free(keys);
+    int largest = 0;
+    for (int b = 0; b < p.numOfBlocks; b++) {
+        for (int i = p.first[b]; i < p.end[b]; i++) {
+            p.block[p.elems[i]] = b;
+            p.loc[p.elems[i]] = i;
+        }
+        if (p.end[b] - p.first[b] > p.end[largest] - p.first[largest]) {
+            largest = b;
+        }
+    }
+
+    //worklist of (block, class) splitters: every initial block but the
+    //largest
+    bool *waiting = (bool *)DFA_min_alloc((size_t)numOfReachable * k, sizeof(bool));
+    int *work = (int *)DFA_min_alloc((size_t)numOfReachable * k, sizeof(int));
+    int numOfWork = 0;
+    for (int b = 0; b < p.numOfBlocks; b++) {
+        if (b == largest) {
+            continue;
+        }
+        for (int c = 0; c < k; c++) {
+            waiting[b*k + c] = true;
+            work[numOfWork++] = b*k + c;
+        }
+    }
+
+    int *splitter = (int *)DFA_min_alloc(numOfReachable, sizeof(int));
+    int *touched = (int *)DFA_min_alloc(numOfReachable, sizeof(int));
+    while (numOfWork > 0) {
+        int item = work[--numOfWork];
+        waiting[item] = false;
+        int b = item / k;
+        int c = item % k;
+        //snapshot the splitter, since marking reorders blocks
+        int size = 0;
+        for (int i = p.first[b]; i < p.end[b]; i++) {
+            splitter[size++] = p.elems[i];
+        }
+        int numOfTouched = 0;
+        for (int i = 0; i < size; i++) {
+            int t = splitter[i];
+            for (int j = predStart[t*k + c]; j < predStart[t*k + c + 1]; j++) {
+                if (PARTITION_mark(&p, preds[j])) {
+                    touched[numOfTouched++] = p.block[preds[j]];
+                }
+            }
+        }
+        for (int i = 0; i < numOfTouched; i++) {
+            int x = touched[i];
+            int marked = p.marked[x];
+            p.marked[x] = 0;
+            if (marked == p.end[x] - p.first[x]) {
+                continue;
+            }
+            //the marked front of x becomes the new block y
+            int y = p.numOfBlocks++;
+            p.first[y] = p.first[x];
+            p.end[y] = p.first[x] + marked;
+            p.first[x] = p.end[y];
+            for (int j = p.first[y]; j < p.end[y]; j++) {
+                p.block[p.elems[j]] = y;
+            }
+            int sizeX = p.end[x] - p.first[x];
+            for (int a = 0; a < k; a++) {
+                int add = waiting[x*k + a] || marked <= sizeX ? y : x;
+                if (!waiting[add*k + a]) {
+                    waiting[add*k + a] = true;
+                    work[numOfWork++] = add*k + a;
+                }
+            }
+        }
+    }
+
+    //number the blocks breadth-first from the start state's block,
+    //leaving out the dead state's block
+    int deadBlock = p.block[dead];
+    int *number = (int *)DFA_min_alloc(p.numOfBlocks, sizeof(int));
+    int *order = (int *)DFA_min_alloc(p.numOfBlocks, sizeof(int));
+    for (int b = 0; b < p.numOfBlocks; b++) {
+        number[b] = -1;
+    }
+    int numOfStates = 0;
+    int startBlock = n > 0 ? p.block[0] : deadBlock;
+    number[startBlock] = numOfStates;
+    order[numOfStates++] = startBlock;
+    for (int head = 0; head < numOfStates; head++) {
+        int s = p.elems[p.first[order[head]]];
+        for (int c = 0; c < k; c++) {
+            int b = p.block[delta[s*k + c]];
+            if (b != deadBlock && number[b] < 0) {
+                number[b] = numOfStates;
+                order[numOfStates++] = b;
+            }
+        }
+    }
+
+    DFA *min = DFA_new(numOfStates);
+    for (int i = 0; i < numOfStates; i++) {
+        if (order[i] == deadBlock) {
+            continue; //the start state itself is dead: no transitions
+        }
+        int s = p.elems[p.first[order[i]]];
+        DFA_set_accepting(min, i, DFA_get_accepting(dfa, s));
+        if (DFA_get_tag(dfa, s) != 0) {
+            DFA_set_tag(min, i, DFA_get_tag(dfa, s));
+        }
+        for (int sym = 0; sym < DFA_NUM_SYMBOLS; sym++) {
+            int b = p.block[delta[s*k + classOf[sym]]];
+            DFA_set_transition(min, i, sym, b == deadBlock ? -1 : number[b]);
+        }
+    }
+
+    if (mapping != NULL) {
+        *mapping = (int *)DFA_min_alloc(n, sizeof(int));
+        for (int s = 0; s < n; s++) {
+            int b = p.block[s];
+            (*mapping)[s] = s < n && reachable[s] && (b != deadBlock || b == startBlock)
+                            ? number[b] : -1;
+        }
+    }
+
+    free(reachable);
+    free(queue);
+    free(delta);
+    free(predStart);
+    free(preds);
+    free(p.elems);
+    free(p.loc);
+    free(p.block);
+    free(p.first);
+    free(p.end);
+    free(p.marked);
+    free(waiting);
+    free(work);
+    free(splitter);
+    free(touched);
+    free(number);
+    free(order);
+    return min;
+}
@@ -0,0 +1,26 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+#ifndef _dfamin_h
+#define _dfamin_h
+
+#include "dfa.h"
+
+/**
+ * Build and return the minimal DFA accepting the same language as the
+ * given DFA, using Hopcroft's partition refinement (O(n k log n) for n
+ * states and k distinct input columns). States are only merged if they
+ * agree on acceptance and tag (DFA_set_tag). Unreachable states are dropped,
+ * and states from which no accepting state can be reached are folded
+ * into the implicit dead state (transitions to them become -1).
+ * State 0 of the result is the block of the original start state.
+ * If mapping is not NULL, *mapping is set to a malloc'ed array giving,
+ * for each state of the given DFA, its state in the result (or -1 if it
+ * was dropped). Don't forget to free() it.
+ */
+extern DFA* DFA_minimize(DFA* dfa, int **mapping);
+
+#endif
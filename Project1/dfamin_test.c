@@ -0,0 +1,193 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: dfamin_test.c
+ *
+ * Test program for DFA minimization: the number of states it leaves for
+ * the automata of problems 1 and 2, the mapping it reports from old
+ * states to new ones, and that the minimized DFAs accept the same inputs.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "nfa.h"
+#include "dfa.h"
+#include "nfatodfa.h"
+#include "dfamin.h"
+#include "test_util.h"
+
+#define NUM_INPUTS 5000
+#define MAX_LEN 24
+
+//sets reachable[s] for each state reachable from the start state, and
+//live[s] for each state from which an accepting state can be reached
+static void mark_states(DFA* dfa, bool *reachable, bool *live) {
+    int n = DFA_get_size(dfa);
+    int *stack = (int*)malloc(n * sizeof(int));
+    if (stack == NULL) {
+        abort();
+    }
+    memset(reachable, 0, n * sizeof(bool));
+    int top = 0;
+    stack[top++] = 0;
+    reachable[0] = true;
+    while (top > 0) {
+        int s = stack[--top];
+        for (int sym = 0; sym < NFA_NUM_SYMBOLS; sym++) {
+            int t = DFA_get_transition(dfa, s, sym);
+            if (t >= 0 && !reachable[t]) {
+                reachable[t] = true;
+                stack[top++] = t;
+            }
+        }
+    }
+    free(stack);
+    for (int s = 0; s < n; s++) {
+        live[s] = DFA_get_accepting(dfa, s);
+    }
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int s = 0; s < n; s++) {
+            for (int sym = 0; sym < NFA_NUM_SYMBOLS && !live[s]; sym++) {
+                int t = DFA_get_transition(dfa, s, sym);
+                if (t >= 0 && live[t]) {
+                    live[s] = true;
+                    changed = true;
+                }
+            }
+        }
+    }
+}
+
+//returns the number of states of the given DFA whose entry in mapping is
+//wrong: reachable states that can still accept must map to a state of
+//min with the same acceptance and tag whose transitions are the mapped
+//ones, and every other state must map to -1
+static int count_wrong_mappings(DFA* dfa, DFA* min, const int *mapping) {
+    int n = DFA_get_size(dfa);
+    bool *reachable = (bool*)malloc(n * sizeof(bool));
+    bool *live = (bool*)malloc(n * sizeof(bool));
+    if (reachable == NULL || live == NULL) {
+        abort();
+    }
+    mark_states(dfa, reachable, live);
+    int wrong = 0;
+    for (int s = 0; s < n; s++) {
+        int m = mapping[s];
+        if (!reachable[s] || !live[s]) {
+            wrong += m != -1;
+            continue;
+        }
+        if (m < 0 || m >= DFA_get_size(min)
+            || DFA_get_accepting(min, m) != DFA_get_accepting(dfa, s)
+            || DFA_get_tag(min, m) != DFA_get_tag(dfa, s)) {
+            wrong++;
+            continue;
+        }
+        for (int sym = 0; sym < NFA_NUM_SYMBOLS; sym++) {
+            int t = DFA_get_transition(dfa, s, sym);
+            if (DFA_get_transition(min, m, sym) != (t < 0 ? -1 : mapping[t])) {
+                wrong++;
+                break;
+            }
+        }
+    }
+    free(reachable);
+    free(live);
+    return wrong;
+}
+
+//returns the number of random inputs over alphabet on which the given
+//DFAs disagree
+static int count_disagreements(DFA* dfa, DFA* min, const char *alphabet) {
+    int k = strlen(alphabet);
+    unsigned char input[MAX_LEN];
+    int disagreements = 0;
+    srand(1);
+    for (int n = 0; n < NUM_INPUTS; n++) {
+        size_t len = rand() % (MAX_LEN + 1);
+        for (size_t i = 0; i < len; i++) {
+            input[i] = alphabet[rand() % k];
+        }
+        if (DFA_run(dfa, input, len) != DFA_run(min, input, len)) {
+            disagreements++;
+        }
+    }
+    return disagreements;
+}
+
+//minimizes the given DFA (freeing it) and checks the result: its size,
+//its mapping, that minimizing it again changes nothing, and that it
+//accepts the same random inputs over alphabet
+static void check_minimize(const char *name, DFA* dfa, const char *alphabet,
+                           int expectedBefore, int expectedAfter) {
+    printf("minimizing %s\n", name);
+    int *mapping = NULL;
+    DFA *min = DFA_minimize(dfa, &mapping);
+    check("states before", DFA_get_size(dfa), expectedBefore);
+    check("states after", DFA_get_size(min), expectedAfter);
+    check("start state maps to 0", mapping[0], 0);
+    check("states with a wrong mapping", count_wrong_mappings(dfa, min, mapping), 0);
+    DFA *again = DFA_minimize(min, NULL);
+    check("states after minimizing again", DFA_get_size(again), expectedAfter);
+    check("inputs where the minimized DFA disagrees",
+          count_disagreements(dfa, min, alphabet), 0);
+    DFA_finalize(min);
+    check("inputs where it disagrees once finalized", count_disagreements(dfa, min, alphabet), 0);
+    free(mapping);
+    DFA_free(again);
+    DFA_free(min);
+    DFA_free(dfa);
+}
+
+//returns the DFA built from the NFA that build returns
+static DFA* subset_dfa(NFA* (*build)()) {
+    NFA *nfa = build();
+    DFA *dfa = nfa_to_dfa(nfa);
+    NFA_free(nfa);
+    return dfa;
+}
+
+int
+main(int argc, char **argv) {
+    check_minimize("problem 1a", problem_1_a_dfa(), "abx", 3, 3);
+    check_minimize("problem 1b", problem_1_b_dfa(), "abx", 3, 3);
+    check_minimize("problem 1c", problem_1_c_dfa(), "01", 2, 2);
+    check_minimize("problem 1d", problem_1_d_dfa(), "01", 4, 4);
+    check_minimize("problem 1e", problem_1_e_dfa(), "01", 4, 4);
+    check_minimize("problem 2a", subset_dfa(problem_2_a_nfa), "manx", 4, 4);
+    check_minimize("problem 2b", subset_dfa(problem_2_b_nfa), "aghinostwnxyz", 26244, 769);
+    check_minimize("problem 2c", subset_dfa(problem_2_c_nfa), "codex", 8, 5);
+
+    //even length over a and b, counted mod 4, with an unreachable state
+    //and a state that can never accept
+    DFA *dfa = DFA_new(6);
+    for (int s = 0; s < 4; s++) {
+        DFA_set_transition(dfa, s, 'a', (s + 1) % 4);
+        DFA_set_transition(dfa, s, 'b', (s + 1) % 4);
+        DFA_set_accepting(dfa, s, s % 2 == 0);
+    }
+    DFA_set_transition(dfa, 1, 'c', 5);
+    DFA_set_transition(dfa, 5, 'a', 5);
+    DFA_set_transition(dfa, 4, 'a', 0);
+    DFA_set_accepting(dfa, 4, true);
+    check_minimize("even length", dfa, "abc", 6, 2);
+
+    //even numbers of a, counted mod 4, with a tag on one accepting state
+    dfa = DFA_new(4);
+    for (int s = 0; s < 4; s++) {
+        DFA_set_transition(dfa, s, 'a', (s + 1) % 4);
+        DFA_set_accepting(dfa, s, s % 2 == 0);
+    }
+    DFA_set_tag(dfa, 2, 7);
+    check_minimize("even length with a tag", dfa, "ab", 4, 4);
+
+    return test_summary();
+}
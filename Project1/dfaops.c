@@ -0,0 +1,241 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: dfaops.c
+ *
+ * One worklist product construction serves every operation, given which
+ * combinations of acceptance it accepts. Bytes that both DFAs treat the
+ * same way share a class, so each pair only steps once per class. Pairs
+ * are numbered in discovery order through an open-addressing hash table
+ * (linear probing, like IntSetTable), so the pairs numbered from the
+ * current one up are the unprocessed worklist.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "dfa.h"
+#include "dfamin.h"
+#include "dfaops.h"
+
+//which combinations of acceptance the result accepts: bit (2*a + b) is
+//set if it accepts when the first DFA does (a) and the second does (b)
+#define DFAOPS_INTERSECT 0x8
+#define DFAOPS_UNION 0xe
+#define DFAOPS_DIFFERENCE 0x4
+#define DFAOPS_COMPLEMENT 0x1
+
+typedef struct {
+    int *pairs;          //pair i is states pairs[2*i] and pairs[2*i + 1],
+                         //either of them -1 where that DFA is stuck
+    int count;
+    int capacity;
+    int *buckets;        //index into pairs, or -1 if free
+    int numOfBuckets;
+} DFAOPS_PRODUCT;
+
+//returns true if a pair with the given states can still reach a
+//combination in op: a stuck state only ever rejects
+static bool dfaops_can_accept(int op, int p, int q) {
+    int reachable = 0xf;
+    if (p < 0) {
+        reachable &= 0x3;
+    }
+    if (q < 0) {
+        reachable &= 0x5;
+    }
+    return (op & reachable) != 0;
+}
+
+static unsigned dfaops_hash(int p, int q) {
+    return ((unsigned)(p + 1)*2654435761u) ^ ((unsigned)(q + 1)*40503u);
+}
+
+//returns the number of the pair (p, q), adding it if it is new
+static int dfaops_intern(DFAOPS_PRODUCT *product, int p, int q) {
+    if (2*(product->count + 1) > product->numOfBuckets) {
+        //grow the buckets and rehash every pair into them
+        free(product->buckets);
+        product->numOfBuckets *= 2;
+        product->buckets = (int *)malloc(product->numOfBuckets*sizeof(int));
+        if (product->buckets == NULL) {
+            abort();
+        }
+        for (int i = 0; i < product->numOfBuckets; i++) {
+            product->buckets[i] = -1;
+        }
+        int mask = product->numOfBuckets - 1;
+        for (int i = 0; i < product->count; i++) {
+            int bucket = dfaops_hash(product->pairs[2*i], product->pairs[2*i + 1]) & mask;
+            while (product->buckets[bucket] != -1) {
+                bucket = (bucket + 1) & mask;
+            }
+            product->buckets[bucket] = i;
+        }
+    }
+    int mask = product->numOfBuckets - 1;
+    int bucket = dfaops_hash(p, q) & mask;
+    while (product->buckets[bucket] != -1) {
+        int i = product->buckets[bucket];
+        if (product->pairs[2*i] == p && product->pairs[2*i + 1] == q) {
+            return i;
+        }
+        bucket = (bucket + 1) & mask;
+    }
+    if (product->count == product->capacity) {
+        product->capacity *= 2;
+        product->pairs = realloc(product->pairs, 2*product->capacity*sizeof(int));
+        if (product->pairs == NULL) {
+            abort();
+        }
+    }
+    product->pairs[2*product->count] = p;
+    product->pairs[2*product->count + 1] = q;
+    product->buckets[bucket] = product->count;
+    return product->count++;
+}
+
+//returns the state reached from state on byte b, or -1 if stuck
+static int dfaops_next(DFA* dfa, int state, int b) {
+    return dfa != NULL && state >= 0 ? DFA_get_transition(dfa, state, (char)b) : -1;
+}
+
+//numbers the classes of bytes on which both DFAs have the same columns
+//of transitions, setting classOf for each byte and a representative byte
+//for each class; returns the number of classes
+static int dfaops_classes(DFA* a, DFA* b, int *classOf, int *representative) {
+    unsigned long long hash[256];
+    for (int c = 0; c < 256; c++) {
+        hash[c] = 14695981039346656037ULL;
+        for (int s = 0; s < DFA_get_size(a); s++) {
+            hash[c] = (hash[c] ^ (unsigned)dfaops_next(a, s, c)) * 1099511628211ULL;
+        }
+        for (int s = 0; b != NULL && s < DFA_get_size(b); s++) {
+            hash[c] = (hash[c] ^ (unsigned)dfaops_next(b, s, c)) * 1099511628211ULL;
+        }
+    }
+    int numOfClasses = 0;
+    for (int c = 0; c < 256; c++) {
+        classOf[c] = -1;
+        for (int k = 0; k < numOfClasses && classOf[c] < 0; k++) {
+            int r = representative[k];
+            if (hash[r] != hash[c]) {
+                continue;
+            }
+            bool same = true;
+            for (int s = 0; s < DFA_get_size(a) && same; s++) {
+                same = dfaops_next(a, s, c) == dfaops_next(a, s, r);
+            }
+            for (int s = 0; b != NULL && s < DFA_get_size(b) && same; s++) {
+                same = dfaops_next(b, s, c) == dfaops_next(b, s, r);
+            }
+            if (same) {
+                classOf[c] = k;
+            }
+        }
+        if (classOf[c] < 0) {
+            representative[numOfClasses] = c;
+            classOf[c] = numOfClasses++;
+        }
+    }
+    return numOfClasses;
+}
+
+//builds the reachable product of a and b (NULL for a DFA that is always
+//stuck) accepting the combinations in op, and minimizes it if asked to
+static DFA* dfaops_product(DFA* a, DFA* b, int op, bool minimize) {
+    DFAOPS_PRODUCT product;
+    product.count = 0;
+    product.capacity = 16;
+    product.pairs = (int *)malloc(2*product.capacity*sizeof(int));
+    product.numOfBuckets = 64;
+    product.buckets = (int *)malloc(product.numOfBuckets*sizeof(int));
+    if (product.pairs == NULL || product.buckets == NULL) {
+        abort();
+    }
+    for (int i = 0; i < product.numOfBuckets; i++) {
+        product.buckets[i] = -1;
+    }
+
+    int classOf[256];
+    int representative[256];
+    int numOfClasses = dfaops_classes(a, b, classOf, representative);
+    int p = DFA_get_size(a) > 0 ? 0 : -1;
+    int q = b != NULL && DFA_get_size(b) > 0 ? 0 : -1;
+    int *rows = NULL;   //numOfClasses successors per pair, -1 if dead
+    int numOfRows = 0;
+    //the start pair is kept even if it cannot accept, so the result has
+    //a start state and rejects every input
+    dfaops_intern(&product, p, q);
+    for (int current = 0; current < product.count; current++) {
+        if (current == numOfRows) {
+            numOfRows = numOfRows == 0 ? 16 : 2*numOfRows;
+            rows = realloc(rows, (size_t)numOfRows*numOfClasses*sizeof(int));
+            if (rows == NULL) {
+                abort();
+            }
+        }
+        p = product.pairs[2*current];
+        q = product.pairs[2*current + 1];
+        for (int k = 0; k < numOfClasses; k++) {
+            int nextP = dfaops_next(a, p, representative[k]);
+            int nextQ = dfaops_next(b, q, representative[k]);
+            rows[(size_t)current*numOfClasses + k] = dfaops_can_accept(op, nextP, nextQ)
+                ? dfaops_intern(&product, nextP, nextQ) : -1;
+        }
+    }
+
+    DFA *dfa = DFA_new(product.count);
+    for (int state = 0; state < product.count; state++) {
+        for (int c = 0; c < 256; c++) {
+            DFA_set_transition(dfa, state, (char)c, rows[(size_t)state*numOfClasses + classOf[c]]);
+        }
+        p = product.pairs[2*state];
+        q = product.pairs[2*state + 1];
+        int acceptP = p >= 0 && DFA_get_accepting(a, p);
+        int acceptQ = q >= 0 && DFA_get_accepting(b, q);
+        DFA_set_accepting(dfa, state, (op >> (2*acceptP + acceptQ)) & 1);
+    }
+    free(rows);
+    free(product.pairs);
+    free(product.buckets);
+    if (minimize) {
+        DFA *min = DFA_minimize(dfa, NULL);
+        DFA_free(dfa);
+        dfa = min;
+    }
+    return dfa;
+}
+
+/**
+ * Build and return a new DFA accepting the inputs both given DFAs accept.
+ */
+extern DFA* DFA_intersect(DFA* a, DFA* b, bool minimize) {
+    return dfaops_product(a, b, DFAOPS_INTERSECT, minimize);
+}
+
+/**
+ * Build and return a new DFA accepting the inputs either given DFA accepts.
+ */
+extern DFA* DFA_union(DFA* a, DFA* b, bool minimize) {
+    return dfaops_product(a, b, DFAOPS_UNION, minimize);
+}
+
+/**
+ * Build and return a new DFA accepting the inputs a accepts but b does not.
+ */
+extern DFA* DFA_difference(DFA* a, DFA* b, bool minimize) {
+    return dfaops_product(a, b, DFAOPS_DIFFERENCE, minimize);
+}
+
+/**
+ * Build and return a new DFA accepting the inputs the given DFA does not.
+ */
+extern DFA* DFA_complement(DFA* dfa, bool minimize) {
+    return dfaops_product(dfa, NULL, DFAOPS_COMPLEMENT, minimize);
+}
@@ -0,0 +1,57 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: dfaops.h
+ *
+ * Combining DFAs with the product construction: a state of the result is
+ * a pair of states, one from each DFA, and both move on every byte, so a
+ * combined rule is run in one pass instead of one pass per DFA. Problems
+ * 1d and 1e are built this way by hand: each is a product of two parity
+ * automata.
+ *
+ * Only pairs reachable from the pair of start states are built, and pairs
+ * that can no longer be accepted (like any pair with a stuck state, for
+ * an intersection) become the implicit dead state as soon as they are
+ * met. The pair of start states is always kept as state 0, so an empty
+ * result is one rejecting state rather than a DFA with no states. Each
+ * operation can also minimize its result with DFA_minimize.
+ * Tags (DFA_set_tag) are not carried over.
+ */
+
+#ifndef _dfaops_h
+#define _dfaops_h
+
+#include <stdbool.h>
+#include "dfa.h"
+
+/**
+ * Build and return a new DFA accepting the inputs both given DFAs accept.
+ * If minimize is true, the result is minimized.
+ */
+extern DFA* DFA_intersect(DFA* a, DFA* b, bool minimize);
+
+/**
+ * Build and return a new DFA accepting the inputs either given DFA
+ * accepts. If minimize is true, the result is minimized.
+ */
+extern DFA* DFA_union(DFA* a, DFA* b, bool minimize);
+
+/**
+ * Build and return a new DFA accepting the inputs a accepts but b does
+ * not. If minimize is true, the result is minimized.
+ */
+extern DFA* DFA_difference(DFA* a, DFA* b, bool minimize);
+
+/**
+ * Build and return a new DFA accepting exactly the inputs the given DFA
+ * does not accept. Where the DFA gets stuck the result goes to an
+ * explicit accepting state that loops on every byte. If minimize is true,
+ * the result is minimized.
+ */
+extern DFA* DFA_complement(DFA* dfa, bool minimize);
+
+#endif
@@ -0,0 +1,103 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: dfaops_test.c
+ *
+ * Test program for the DFA product operations, including DFAs that accept
+ * nothing, DFAs with no states and DFAs that get stuck.
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include "dfa.h"
+#include "dfaops.h"
+#include "test_util.h"
+
+//runs the given DFA on the given string, before and after finalizing it
+static bool runs(DFA* dfa, const char *input) {
+    bool before = DFA_run(dfa, (const unsigned char *)input, strlen(input));
+    DFA_finalize(dfa);
+    bool after = DFA_run(dfa, (const unsigned char *)input, strlen(input));
+    if (before != after) {
+        printf("  FAILED: finalizing changed the result on \"%s\"\n", input);
+        test_failures++;
+    }
+    return after;
+}
+
+int
+main(int argc, char **argv) {
+    DFA *none = DFA_new(0);
+    DFA *ab = problem_1_a_dfa();
+    DFA *startsAb = problem_1_b_dfa();
+    DFA *evenOnes = problem_1_c_dfa();
+
+    printf("empty and stuck operands\n");
+    for (int minimize = 0; minimize < 2; minimize++) {
+        printf("minimize = %d\n", minimize);
+        DFA *dfa = DFA_intersect(none, ab, minimize);
+        check("no states & ab has a state", DFA_get_size(dfa) > 0, true);
+        check("no states & ab accepts \"\"", runs(dfa, ""), false);
+        check("no states & ab accepts ab", runs(dfa, "ab"), false);
+        DFA_free(dfa);
+
+        dfa = DFA_intersect(ab, evenOnes, minimize);
+        check("ab & even 1s has a state", DFA_get_size(dfa) > 0, true);
+        check("ab & even 1s accepts ab", runs(dfa, "ab"), false);
+        check("ab & even 1s accepts 11", runs(dfa, "11"), false);
+        DFA_free(dfa);
+
+        dfa = DFA_difference(none, ab, minimize);
+        check("no states - ab accepts ab", runs(dfa, "ab"), false);
+        DFA_free(dfa);
+
+        dfa = DFA_union(none, ab, minimize);
+        check("no states | ab accepts ab", runs(dfa, "ab"), true);
+        check("no states | ab accepts a", runs(dfa, "a"), false);
+        DFA_free(dfa);
+
+        dfa = DFA_difference(ab, none, minimize);
+        check("ab - no states accepts ab", runs(dfa, "ab"), true);
+        check("ab - no states accepts abc", runs(dfa, "abc"), false);
+        DFA_free(dfa);
+
+        dfa = DFA_complement(none, minimize);
+        check("not no states accepts \"\"", runs(dfa, ""), true);
+        check("not no states accepts xyz", runs(dfa, "xyz"), true);
+        DFA_free(dfa);
+
+        dfa = DFA_complement(ab, minimize);
+        check("not ab accepts a", runs(dfa, "a"), true);
+        check("not ab accepts ab", runs(dfa, "ab"), false);
+        check("not ab accepts abx", runs(dfa, "abx"), true);
+        DFA_free(dfa);
+
+        dfa = DFA_intersect(ab, startsAb, minimize);
+        check("ab & starts with ab accepts ab", runs(dfa, "ab"), true);
+        check("ab & starts with ab accepts abc", runs(dfa, "abc"), false);
+        DFA_free(dfa);
+
+        dfa = DFA_difference(startsAb, ab, minimize);
+        check("starts with ab - ab accepts ab", runs(dfa, "ab"), false);
+        check("starts with ab - ab accepts abc", runs(dfa, "abc"), true);
+        check("starts with ab - ab accepts ba", runs(dfa, "ba"), false);
+        DFA_free(dfa);
+
+        dfa = DFA_union(ab, evenOnes, minimize);
+        check("ab | even 1s accepts ab", runs(dfa, "ab"), true);
+        check("ab | even 1s accepts 0110", runs(dfa, "0110"), true);
+        check("ab | even 1s accepts 010", runs(dfa, "010"), false);
+        DFA_free(dfa);
+    }
+
+    DFA_free(none);
+    DFA_free(ab);
+    DFA_free(startsAb);
+    DFA_free(evenOnes);
+    return test_summary();
+}
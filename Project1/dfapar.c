@@ -0,0 +1,158 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "dfapar.h"
+
+//the first block each chunk runs from every state; later blocks double in
+//size up to the largest, since by then most start states have merged
+#define PARALLEL_FIRST_BLOCK 64
+#define PARALLEL_LAST_BLOCK 65536
+
+//one thread's share of the input and the state map it produces:
+//map[s] is the state reached from s at the end of the chunk, or -1
+typedef struct {
+    const DFA *dfa;
+    const unsigned char *input;
+    size_t len;
+    int *map;
+} ParallelChunk;
+
+//runs a chunk from every state at once. Runs from different start states
+//that reach the same state behave the same from then on, so after each
+//block they are merged and only the distinct live states are advanced
+static void *DFA_run_chunk(void *arg) {
+    ParallelChunk *chunk = (ParallelChunk *)arg;
+    int n = DFA_get_size(chunk->dfa);
+    int *slot = chunk->map;                        //start state -> index in live, or -1
+    int *live = (int *)malloc(n*sizeof(int));      //distinct states being advanced
+    int *remap = (int *)malloc(n*sizeof(int));     //old index in live -> new index
+    int *owner = (int *)malloc(n*sizeof(int));     //state -> its new index while merging
+    if (n > 0 && (live == NULL || remap == NULL || owner == NULL)) {
+        abort();
+    }
+    int numLive = n;
+    for (int s = 0; s < n; s++) {
+        slot[s] = s;
+        live[s] = s;
+        owner[s] = -1;
+    }
+
+    size_t pos = 0;
+    size_t block = PARALLEL_FIRST_BLOCK;
+    while (pos < chunk->len && numLive > 0) {
+        //with one live state left there is nothing to merge, so run the rest
+        size_t len = chunk->len - pos;
+        if (numLive > 1 && len > block) {
+            len = block;
+        }
+        for (int k = 0; k < numLive; k++) {
+            DFA_Cursor cursor = { chunk->dfa, live[k] };
+            DFA_Cursor_feed(&cursor, chunk->input + pos, len);
+            live[k] = cursor.state;
+        }
+        pos += len;
+        if (block < PARALLEL_LAST_BLOCK) {
+            block *= 2;
+        }
+
+        //drop dead states and merge duplicates, keeping live in order so
+        //it can be compacted in place
+        int merged = 0;
+        for (int k = 0; k < numLive; k++) {
+            int state = live[k];
+            if (state < 0) {
+                remap[k] = -1;
+            } else if (owner[state] >= 0) {
+                remap[k] = owner[state];
+            } else {
+                owner[state] = merged;
+                remap[k] = merged;
+                live[merged++] = state;
+            }
+        }
+        for (int k = 0; k < merged; k++) {
+            owner[live[k]] = -1;
+        }
+        if (merged < numLive) {
+            for (int s = 0; s < n; s++) {
+                if (slot[s] >= 0) {
+                    slot[s] = remap[slot[s]];
+                }
+            }
+        }
+        numLive = merged;
+    }
+
+    for (int s = 0; s < n; s++) {
+        chunk->map[s] = slot[s] < 0 ? -1 : live[slot[s]];
+    }
+    free(live);
+    free(remap);
+    free(owner);
+    return NULL;
+}
+
+/**
+ * Run the given DFA on the len bytes of input using up to nthreads
+ * threads and return true if it accepts.
+ */
+extern bool DFA_run_parallel(const DFA* dfa, const unsigned char *input, size_t len, int nthreads) {
+    if (nthreads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        nthreads = cpus > 0 ? (int)cpus : 1;
+    }
+    if ((size_t)nthreads > len / PARALLEL_MIN_CHUNK) {
+        nthreads = (int)(len / PARALLEL_MIN_CHUNK);
+    }
+    if (nthreads <= 1) {
+        return DFA_run(dfa, input, len);
+    }
+
+    //the first chunk's start state is known, so this thread runs it
+    //normally while the others build their maps
+    int n = DFA_get_size(dfa);
+    size_t share = len / nthreads;
+    ParallelChunk *chunks = (ParallelChunk *)malloc(nthreads*sizeof(ParallelChunk));
+    pthread_t *threads = (pthread_t *)malloc(nthreads*sizeof(pthread_t));
+    bool *started = (bool *)malloc(nthreads*sizeof(bool));
+    if (chunks == NULL || threads == NULL || started == NULL) {
+        abort();
+    }
+    for (int i = 1; i < nthreads; i++) {
+        chunks[i].dfa = dfa;
+        chunks[i].input = input + i*share;
+        chunks[i].len = i == nthreads - 1 ? len - i*share : share;
+        chunks[i].map = (int *)malloc(n*sizeof(int));
+        if (chunks[i].map == NULL) {
+            abort();
+        }
+        started[i] = pthread_create(&threads[i], NULL, DFA_run_chunk, &chunks[i]) == 0;
+    }
+    DFA_Cursor cursor;
+    DFA_Cursor_init(&cursor, dfa);
+    DFA_Cursor_feed(&cursor, input, share);
+
+    //compose the maps in order; a chunk whose thread could not be started
+    //is simply run here once its start state is known
+    for (int i = 1; i < nthreads; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+            if (cursor.state >= 0) {
+                cursor.state = chunks[i].map[cursor.state];
+            }
+        } else {
+            DFA_Cursor_feed(&cursor, chunks[i].input, chunks[i].len);
+        }
+        free(chunks[i].map);
+    }
+    free(chunks);
+    free(threads);
+    free(started);
+    return DFA_Cursor_is_accepting(&cursor);
+}
@@ -0,0 +1,38 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: dfapar.h
+ *
+ * Running a DFA over one large input on several threads. The input is
+ * cut into one chunk per thread; since the state a chunk starts in is not
+ * known until the chunks before it are done, each thread runs its chunk
+ * from every state at once and records where each start state ends up.
+ * Composing those maps in order gives the state at the end of the input.
+ */
+
+#ifndef _dfapar_h
+#define _dfapar_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "dfa.h"
+
+/**
+ * Inputs shorter than this many bytes per thread are not worth splitting
+ * and are run on fewer threads.
+ */
+#define PARALLEL_MIN_CHUNK (1 << 20)
+
+/**
+ * Run the given DFA on the len bytes of input using up to nthreads
+ * threads (0 means one per online CPU) and return true if it accepts.
+ * Gives the same answer as DFA_run. The DFA should be finalized first,
+ * since it is only read.
+ */
+extern bool DFA_run_parallel(const DFA* dfa, const unsigned char *input, size_t len, int nthreads);
+
+#endif
@@ -0,0 +1,190 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: dfapar_test.c
+ *
+ * Test program for running a DFA on several threads: DFA_run_parallel
+ * against DFA_run on inputs of several chunks, for DFAs that get stuck
+ * partway through a chunk, that reach an accepting trap, and that have
+ * many states, with interesting bytes on the chunk boundaries.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "dfa.h"
+#include "nfa.h"
+#include "nfatodfa.h"
+#include "dfapar.h"
+#include "test_util.h"
+
+//long enough for 8 threads to each get a chunk, and not a multiple of
+//any number of them
+#define INPUT_SIZE (8 * PARALLEL_MIN_CHUNK + 12345)
+
+static const int threadCounts[] = { 2, 3, 8 };
+
+//checks DFA_run_parallel with each number of threads against DFA_run on
+//the len bytes at input, where expected is what DFA_run should give
+static void check_parallel(const char *what, const DFA* dfa, const unsigned char *input,
+                           size_t len, bool expected) {
+    char name[128];
+    snprintf(name, sizeof(name), "%s (DFA_run)", what);
+    check(name, DFA_run(dfa, input, len), expected);
+    for (int i = 0; i < 3; i++) {
+        snprintf(name, sizeof(name), "%s (%d threads)", what, threadCounts[i]);
+        check(name, DFA_run_parallel(dfa, input, len, threadCounts[i]), expected);
+    }
+}
+
+//returns where the given chunk starts when len bytes are split among
+//nthreads threads
+static size_t chunk_start(size_t len, int nthreads, int chunk) {
+    return (len / nthreads) * chunk;
+}
+
+//returns true for the chunks worth checking one at a time: the first,
+//the second, one in the middle and the last
+static bool is_checked(int chunk, int nthreads) {
+    return chunk <= 1 || chunk == nthreads / 2 || chunk == nthreads - 1;
+}
+
+//fills the len bytes at input with random bytes from alphabet
+static void fill(unsigned char *input, size_t len, const char *alphabet) {
+    int k = strlen(alphabet);
+    for (size_t i = 0; i < len; i++) {
+        input[i] = alphabet[rand() % k];
+    }
+}
+
+int
+main(int argc, char **argv) {
+    unsigned char *input = (unsigned char*)malloc(INPUT_SIZE);
+    if (input == NULL) {
+        abort();
+    }
+    size_t len = INPUT_SIZE;
+    srand(1);
+
+    printf("an even number of 1s\n");
+    DFA *dfa = problem_1_c_dfa();
+    DFA_finalize(dfa);
+    fill(input, len, "01");
+    bool even = DFA_run(dfa, input, len);
+    check_parallel("random bits", dfa, input, len, even);
+    input[len - 1] ^= 1;
+    check_parallel("random bits, last one flipped", dfa, input, len, !even);
+    input[len / 2] = 'x';
+    check_parallel("and an x in the middle", dfa, input, len, false);
+    DFA_free(dfa);
+
+    printf("an x only after an even number of 1s, getting stuck partway through a chunk\n");
+    //from one start state a chunk gets stuck at an x and from the other not
+    dfa = DFA_new(2);
+    DFA_set_transition_str(dfa, 0, "0x", 0);
+    DFA_set_transition(dfa, 0, '1', 1);
+    DFA_set_transition(dfa, 1, '0', 1);
+    DFA_set_transition(dfa, 1, '1', 0);
+    DFA_set_accepting(dfa, 0, true);
+    DFA_finalize(dfa);
+    fill(input, len, "01");
+    for (int i = 0; i < 3; i++) {
+        int nthreads = threadCounts[i];
+        for (int chunk = 0; chunk < nthreads; chunk++) {
+            if (!is_checked(chunk, nthreads)) {
+                continue;
+            }
+            size_t at = chunk_start(len, nthreads, chunk) + len / nthreads / 2;
+            unsigned char saved = input[at];
+            input[at] = 'x';
+            char what[80];
+            snprintf(what, sizeof(what), "an x halfway through chunk %d of %d", chunk, nthreads);
+            check_parallel(what, dfa, input, len, DFA_run(dfa, input, len));
+            //the same with the bit before the x flipped, so that the run
+            //gets stuck there in exactly one of the two
+            input[at - 1] ^= 1;
+            snprintf(what, sizeof(what), "an x halfway through chunk %d of %d, bit flipped",
+                     chunk, nthreads);
+            check_parallel(what, dfa, input, len, DFA_run(dfa, input, len));
+            input[at - 1] ^= 1;
+            input[at] = saved;
+        }
+    }
+    DFA_free(dfa);
+
+    printf("an even number of 1s and of 0s\n");
+    dfa = problem_1_d_dfa();
+    DFA_finalize(dfa);
+    fill(input, len, "01");
+    bool expected = DFA_run(dfa, input, len);
+    check_parallel("random bits", dfa, input, len, expected);
+    input[len / 2] ^= 1;
+    check_parallel("one bit flipped", dfa, input, len, DFA_run(dfa, input, len));
+    DFA_free(dfa);
+
+    printf("code anywhere, reaching an accepting trap\n");
+    NFA *nfa = problem_2_c_nfa();
+    dfa = nfa_to_dfa(nfa);
+    NFA_free(nfa);
+    DFA_finalize(dfa);
+    fill(input, len, "cdeox");
+    for (size_t i = 3; i < len; i++) {
+        //no code anywhere to begin with
+        if (memcmp(input + i - 3, "code", 4) == 0) {
+            input[i] = 'x';
+        }
+    }
+    check_parallel("no code", dfa, input, len, false);
+    for (int i = 0; i < 3; i++) {
+        int nthreads = threadCounts[i];
+        for (int chunk = 1; chunk < nthreads; chunk++) {
+            if (!is_checked(chunk, nthreads)) {
+                continue;
+            }
+            //code split across the boundary in each way
+            size_t boundary = chunk_start(len, nthreads, chunk);
+            for (size_t before = 1; before <= 3; before++) {
+                unsigned char saved[4];
+                memcpy(saved, input + boundary - before, 4);
+                memcpy(input + boundary - before, "code", 4);
+                char what[64];
+                snprintf(what, sizeof(what), "code at %zu, by the start of chunk %d of %d",
+                         boundary - before, chunk, nthreads);
+                check_parallel(what, dfa, input, len, true);
+                memcpy(input + boundary - before, saved, 4);
+            }
+        }
+    }
+    memcpy(input + 10, "code", 4);
+    check_parallel("code at the start", dfa, input, len, true);
+    DFA_free(dfa);
+
+    printf("the 12th bit from the end is 1, with 4096 states\n");
+    nfa = NFA_new(13);
+    NFA_add_transition_str(nfa, 0, "01", 0);
+    NFA_add_transition(nfa, 0, '1', 1);
+    for (int s = 1; s < 12; s++) {
+        NFA_add_transition_str(nfa, s, "01", s + 1);
+    }
+    NFA_set_accepting(nfa, 12, true);
+    dfa = nfa_to_dfa(nfa);
+    NFA_free(nfa);
+    DFA_finalize(dfa);
+    check("states", DFA_get_size(dfa), 4096);
+    fill(input, len, "01");
+    input[len - 12] = '1';
+    check_parallel("random bits with a 1", dfa, input, len, true);
+    input[len - 12] = '0';
+    check_parallel("random bits with a 0", dfa, input, len, false);
+    input[len - 11] = 'x';
+    check_parallel("and then an x", dfa, input, len, false);
+    DFA_free(dfa);
+
+    free(input);
+    return test_summary();
+}
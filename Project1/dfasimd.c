@@ -0,0 +1,287 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "dfasimd.h"
+
+//how many bytes to run between checks for a stopping state
+#define SHUFFLE_BLOCK 64
+
+//scalar version: the tables are only 16 bytes per class, so the dependent
+//load always hits L1
+static int shuffle_run_scalar(const unsigned char (*tables)[SHUFFLE_MAX_STATES],
+                              const unsigned char *classMap, unsigned stops, int start,
+                              const unsigned char *input, size_t len) {
+    int state = start;
+    for (size_t i = 0; i < len; i++) {
+        state = tables[classMap[input[i]]][state];
+        if ((stops >> state) & 1) {
+            break;
+        }
+    }
+    return state;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+
+__attribute__((target("ssse3")))
+static int shuffle_run_ssse3(const unsigned char (*tables)[SHUFFLE_MAX_STATES],
+                             const unsigned char *classMap, unsigned stops, int start,
+                             const unsigned char *input, size_t len) {
+    __m128i v = _mm_set1_epi8((char)start);
+    unsigned char lanes[SHUFFLE_MAX_STATES];
+    size_t i = 0;
+    while (i < len) {
+        size_t end = len - i > SHUFFLE_BLOCK ? i + SHUFFLE_BLOCK : len;
+        for (; i < end; i++) {
+            __m128i t = _mm_loadu_si128((const __m128i *)tables[classMap[input[i]]]);
+            v = _mm_shuffle_epi8(t, v);
+        }
+        _mm_storeu_si128((__m128i *)lanes, v);
+        if ((stops >> lanes[0]) & 1) {
+            break;
+        }
+    }
+    _mm_storeu_si128((__m128i *)lanes, v);
+    return lanes[0];
+}
+
+//true if the CPU can run the SSSE3 kernel (checked once); the cache is
+//atomic because the first runs may come from several threads at once,
+//which then all store the same answer
+static bool shuffle_have_simd() {
+    static int supported = -1;
+    int cached = __atomic_load_n(&supported, __ATOMIC_RELAXED);
+    if (cached < 0) {
+        cached = __builtin_cpu_supports("ssse3") ? 1 : 0;
+        __atomic_store_n(&supported, cached, __ATOMIC_RELAXED);
+    }
+    return cached;
+}
+#define shuffle_run_simd shuffle_run_ssse3
+
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+
+static int shuffle_run_neon(const unsigned char (*tables)[SHUFFLE_MAX_STATES],
+                            const unsigned char *classMap, unsigned stops, int start,
+                            const unsigned char *input, size_t len) {
+    uint8x16_t v = vdupq_n_u8((uint8_t)start);
+    size_t i = 0;
+    while (i < len) {
+        size_t end = len - i > SHUFFLE_BLOCK ? i + SHUFFLE_BLOCK : len;
+        for (; i < end; i++) {
+            v = vqtbl1q_u8(vld1q_u8(tables[classMap[input[i]]]), v);
+        }
+        if ((stops >> vgetq_lane_u8(v, 0)) & 1) {
+            break;
+        }
+    }
+    return vgetq_lane_u8(v, 0);
+}
+
+static bool shuffle_have_simd() {
+    return true;
+}
+#define shuffle_run_simd shuffle_run_neon
+
+#else
+
+static bool shuffle_have_simd() {
+    return false;
+}
+#define shuffle_run_simd shuffle_run_scalar
+
+#endif
+
+/**
+ * Run len bytes of input from state start through the given shuffle
+ * tables and return the state reached.
+ */
+extern int shuffle_run(const unsigned char (*tables)[SHUFFLE_MAX_STATES],
+                       const unsigned char *classMap, unsigned stops, int start,
+                       const unsigned char *input, size_t len) {
+    if (shuffle_have_simd()) {
+        return shuffle_run_simd(tables, classMap, stops, start, input, len);
+    }
+    return shuffle_run_scalar(tables, classMap, stops, start, input, len);
+}
+
+/**
+ * Return the position of the first byte in [p, end) equal to b0, b1 or
+ * b2, or end if there is none, comparing 8 bytes at a time: a byte of x
+ * is zero exactly where the word matched, and (x - 0x01..) & ~x sets the
+ * high bit of some byte if any byte of x is zero.
+ */
+extern const unsigned char *find_bytes_swar(const unsigned char *p, const unsigned char *end,
+                                            unsigned char b0, unsigned char b1, unsigned char b2) {
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t highs = 0x8080808080808080ULL;
+    while (end - p >= 8) {
+        uint64_t word;
+        memcpy(&word, p, 8);
+        uint64_t x0 = word ^ (ones*b0);
+        uint64_t x1 = word ^ (ones*b1);
+        uint64_t x2 = word ^ (ones*b2);
+        uint64_t found = ((x0 - ones) & ~x0) | ((x1 - ones) & ~x1) | ((x2 - ones) & ~x2);
+        if ((found & highs) != 0) {
+            break;
+        }
+        p += 8;
+    }
+    while (p < end && *p != b0 && *p != b1 && *p != b2) {
+        p++;
+    }
+    return p;
+}
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+static const unsigned char *find_bytes_sse2(const unsigned char *p, const unsigned char *end,
+                                            unsigned char b0, unsigned char b1, unsigned char b2) {
+    __m128i v0 = _mm_set1_epi8((char)b0);
+    __m128i v1 = _mm_set1_epi8((char)b1);
+    __m128i v2 = _mm_set1_epi8((char)b2);
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)p);
+        __m128i eq = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, v0), _mm_cmpeq_epi8(chunk, v1)),
+                                  _mm_cmpeq_epi8(chunk, v2));
+        int mask = _mm_movemask_epi8(eq);
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 16;
+    }
+    return find_bytes_swar(p, end, b0, b1, b2);
+}
+#define find_bytes_wide find_bytes_sse2
+
+#else
+#define find_bytes_wide find_bytes_swar
+#endif
+
+/**
+ * Return the position of the first byte in [start, end) equal to one of
+ * the count given bytes, or end if there is none.
+ */
+extern const unsigned char *find_bytes(const unsigned char *start, const unsigned char *end,
+                                       const unsigned char *bytes, int count) {
+    if (count == 1) {
+        const unsigned char *found = memchr(start, bytes[0], end - start);
+        return found != NULL ? found : end;
+    }
+    //with two bytes the last one is simply checked twice
+    return find_bytes_wide(start, end, bytes[0], bytes[1], bytes[count - 1]);
+}
+
+/**
+ * Fill in the nibble tables of the given ByteSet.
+ */
+extern void byteset_init(ByteSet *set, const bool *member) {
+    memset(set->lo, 0, sizeof(set->lo));
+    memset(set->hi, 0, sizeof(set->hi));
+    for (int b = 0; b < 256; b++) {
+        set->member[b] = member[b];
+        if (member[b]) {
+            unsigned char bucket = 1 << ((b >> 4) & 7);
+            set->lo[b & 15] |= bucket;
+            set->hi[b >> 4] |= bucket;
+        }
+    }
+}
+
+//checks the candidates (set bits of mask) among the 16 bytes at p, and
+//returns the first one really in the set, or NULL
+static const unsigned char *byteset_check(const unsigned char *p, unsigned mask, const ByteSet *set) {
+    while (mask != 0) {
+        int i = __builtin_ctz(mask);
+        if (set->member[p[i]]) {
+            return p + i;
+        }
+        mask &= mask - 1;
+    }
+    return NULL;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+__attribute__((target("ssse3")))
+static const unsigned char *find_byteset_simd(const unsigned char *p, const unsigned char *end,
+                                              const ByteSet *set) {
+    __m128i lo = _mm_loadu_si128((const __m128i *)set->lo);
+    __m128i hi = _mm_loadu_si128((const __m128i *)set->hi);
+    __m128i nibble = _mm_set1_epi8(15);
+    __m128i zero = _mm_setzero_si128();
+    while (end - p >= 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i *)p);
+        __m128i low = _mm_shuffle_epi8(lo, _mm_and_si128(chunk, nibble));
+        __m128i high = _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi16(chunk, 4), nibble));
+        unsigned mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(low, high), zero)) & 0xffff;
+        const unsigned char *found = mask != 0 ? byteset_check(p, mask, set) : NULL;
+        if (found != NULL) {
+            return found;
+        }
+        p += 16;
+    }
+    return p;
+}
+
+#elif defined(__aarch64__)
+
+static const unsigned char *find_byteset_simd(const unsigned char *p, const unsigned char *end,
+                                              const ByteSet *set) {
+    uint8x16_t lo = vld1q_u8(set->lo);
+    uint8x16_t hi = vld1q_u8(set->hi);
+    uint8x16_t nibble = vdupq_n_u8(15);
+    while (end - p >= 16) {
+        uint8x16_t chunk = vld1q_u8(p);
+        uint8x16_t hits = vandq_u8(vqtbl1q_u8(lo, vandq_u8(chunk, nibble)),
+                                   vqtbl1q_u8(hi, vshrq_n_u8(chunk, 4)));
+        if (vmaxvq_u8(hits) != 0) {
+            unsigned char lanes[16];
+            vst1q_u8(lanes, hits);
+            unsigned mask = 0;
+            for (int i = 0; i < 16; i++) {
+                mask |= (unsigned)(lanes[i] != 0) << i;
+            }
+            const unsigned char *found = byteset_check(p, mask, set);
+            if (found != NULL) {
+                return found;
+            }
+        }
+        p += 16;
+    }
+    return p;
+}
+
+#else
+
+static const unsigned char *find_byteset_simd(const unsigned char *p, const unsigned char *end,
+                                              const ByteSet *set) {
+    return p;
+}
+
+#endif
+
+/**
+ * Return the position of the first byte in [start, end) that is in the
+ * given set, or end if there is none.
+ */
+extern const unsigned char *find_byteset(const unsigned char *start, const unsigned char *end,
+                                         const ByteSet *set) {
+    const unsigned char *p = start;
+    if (shuffle_have_simd()) {
+        p = find_byteset_simd(p, end, set);
+    }
+    while (p < end && !set->member[*p]) {
+        p++;
+    }
+    return p;
+}
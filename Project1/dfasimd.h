@@ -0,0 +1,90 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: dfasimd.h
+ *
+ * Shuffle-based execution for DFAs of at most 16 states (counting the
+ * dead state). For each byte class c there is a 16-byte table T[c] with
+ * T[c][s] the successor of state s. The start state is copied into every
+ * lane of a vector v, which is advanced with one byte shuffle per input
+ * byte, v = T[c][v]; all lanes stay equal and lane 0 is the state reached.
+ * The shuffle replaces a dependent table load per byte.
+ * dfa.c builds the tables in DFA_finalize and uses this automatically.
+ * Also byte searches for skipping input that cannot change the state.
+ */
+
+#ifndef _dfasimd_h
+#define _dfasimd_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * The largest number of states (including a dead state) a shuffle table
+ * can hold.
+ */
+#define SHUFFLE_MAX_STATES 16
+
+/**
+ * Run len bytes of input from state start through the given shuffle
+ * tables (one per byte class, indexed through classMap) and return the
+ * state reached. stops is a mask of states (bit s for state s), such as
+ * the dead state, that the run may stop early in and return. Uses SSSE3
+ * or NEON byte shuffles when the CPU has them, and a scalar loop over the
+ * same tables otherwise.
+ */
+extern int shuffle_run(const unsigned char (*tables)[SHUFFLE_MAX_STATES],
+                       const unsigned char *classMap, unsigned stops, int start,
+                       const unsigned char *input, size_t len);
+
+/**
+ * Return the position of the first byte in [start, end) equal to one of
+ * the count (1 to 3) given bytes, or end if there is none. Used to skip
+ * over input that keeps a DFA in the same state. One byte is found with
+ * memchr; two or three are compared 16 at a time with SSE2 where
+ * available, 8 at a time in a 64-bit word otherwise.
+ */
+extern const unsigned char *find_bytes(const unsigned char *start, const unsigned char *end,
+                                       const unsigned char *bytes, int count);
+
+/**
+ * The word-at-a-time search find_bytes falls back on for two or three
+ * bytes (pass one of them twice for two): return the position of the
+ * first byte in [start, end) equal to b0, b1 or b2, or end if there is
+ * none. It is exported so that it can be tested where SSE2 is available.
+ */
+extern const unsigned char *find_bytes_swar(const unsigned char *start, const unsigned char *end,
+                                            unsigned char b0, unsigned char b1, unsigned char b2);
+
+/**
+ * A set of bytes prepared for find_byteset. Each byte in the set is put in
+ * one of 8 buckets by its high nibble, and lo[n] and hi[n] hold the
+ * buckets of the bytes in the set with low or high nibble n. A byte whose
+ * lo and hi entries share a bucket may be in the set; member is checked
+ * to make sure.
+ */
+typedef struct {
+    unsigned char lo[16];
+    unsigned char hi[16];
+    bool member[256];
+} ByteSet;
+
+/**
+ * Fill in the given ByteSet from member, which says for each of the 256
+ * byte values whether it is in the set.
+ */
+extern void byteset_init(ByteSet *set, const bool *member);
+
+/**
+ * Return the position of the first byte in [start, end) that is in the
+ * given set, or end if there is none. With SSSE3 or NEON, 16 bytes are
+ * tested at a time by looking up their nibbles with two byte shuffles.
+ */
+extern const unsigned char *find_byteset(const unsigned char *start, const unsigned char *end,
+                                         const ByteSet *set);
+
+#endif
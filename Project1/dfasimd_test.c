@@ -0,0 +1,166 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: dfasimd_test.c
+ *
+ * Test program for the byte searches that skip through states with only
+ * a few exits: find_bytes and find_bytes_swar against a plain loop, and
+ * finalized DFAs whose states leave on one to three bytes against the
+ * same automata run as NFAs, with the exit bytes at every offset.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "dfa.h"
+#include "nfa.h"
+#include "dfasimd.h"
+#include "test_util.h"
+
+#define NUM_SETS 9
+#define MAX_LEN 72
+#define RUN_LEN 160
+
+//sets of exit bytes, with bytes that differ from each other only in the
+//high bit or by one, where word-at-a-time tricks tend to go wrong
+static const unsigned char exitSets[NUM_SETS][3] = {
+    { 'a' }, { 0x00 }, { 0xff },
+    { 'a', 'b' }, { 0x00, 0x80 }, { 0x7f, 0xff },
+    { 'x', 'y', 'z' }, { 0x00, 0x01, 0x80 }, { 0xfe, 0xff, 0x7f }
+};
+static const int exitCounts[NUM_SETS] = { 1, 1, 1, 2, 2, 2, 3, 3, 3 };
+
+//returns true if b is one of the count given bytes
+static bool is_exit(const unsigned char *bytes, int count, unsigned char b) {
+    for (int i = 0; i < count; i++) {
+        if (bytes[i] == b) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//fills the len bytes at input with bytes that are not exits, mostly ones
+//next to an exit byte or equal to one but for the high bit
+static void fill(unsigned char *input, size_t len, const unsigned char *bytes, int count) {
+    for (size_t i = 0; i < len; i++) {
+        unsigned char b;
+        do {
+            unsigned char near = bytes[rand() % count];
+            int pick = rand() % 4;
+            b = pick == 0 ? near ^ 0x80 : pick == 1 ? near + 1 : pick == 2 ? near - 1 : rand();
+        } while (is_exit(bytes, count, b));
+        input[i] = b;
+    }
+}
+
+//returns the number of searches on which find_bytes or find_bytes_swar
+//disagrees with a plain loop, for every length up to MAX_LEN, start
+//alignment and position of an exit byte (or none)
+static int count_wrong_searches(const unsigned char *bytes, int count) {
+    unsigned char buffer[MAX_LEN + 16];
+    int wrong = 0;
+    for (int shift = 0; shift < 16; shift++) {
+        unsigned char *input = buffer + shift;
+        for (int len = 0; len <= MAX_LEN; len++) {
+            for (int at = -1; at < len; at++) {
+                fill(input, len, bytes, count);
+                if (at >= 0) {
+                    input[at] = bytes[at % count];
+                    //a second exit further on must not be found first
+                    if (at + 9 < len) {
+                        input[at + 9] = bytes[0];
+                    }
+                }
+                const unsigned char *expected = input + (at >= 0 ? at : len);
+                const unsigned char *end = input + len;
+                if (find_bytes(input, end, bytes, count) != expected
+                    || find_bytes_swar(input, end, bytes[0], bytes[count > 1],
+                                       bytes[count - 1]) != expected) {
+                    wrong++;
+                }
+            }
+        }
+    }
+    return wrong;
+}
+
+//the automaton that accepts the inputs with an odd number of exit bytes,
+//or with stuck set the one whose first state gets stuck on every exit
+//byte but the first, as a DFA and as an NFA
+static void build(const unsigned char *bytes, int count, bool stuck, DFA** dfa, NFA** nfa) {
+    *dfa = DFA_new(2);
+    *nfa = NFA_new(2);
+    for (int s = 0; s < 2; s++) {
+        for (int b = 0; b < 256; b++) {
+            int next = is_exit(bytes, count, b) ? 1 - s : s;
+            if (stuck && s == 0 && is_exit(bytes, count, b) && b != bytes[0]) {
+                continue;
+            }
+            DFA_set_transition(*dfa, s, b, next);
+            NFA_add_transition(*nfa, s, b, next);
+        }
+    }
+    DFA_set_accepting(*dfa, 1, true);
+    NFA_set_accepting(*nfa, 1, true);
+    NFA_set_backend(*nfa, NFA_BACKEND_SETS);
+    DFA_finalize(*dfa);
+}
+
+//returns the number of runs on which the finalized DFA disagrees with the
+//NFA, with one or two exit bytes at every offset mod 32 (and so mod 16)
+//from several starting alignments, on the shuffle kernel and off it
+static int count_wrong_runs(const unsigned char *bytes, int count, bool stuck) {
+    DFA *dfa;
+    NFA *nfa;
+    build(bytes, count, stuck, &dfa, &nfa);
+    unsigned char buffer[RUN_LEN + 8];
+    int wrong = 0;
+    for (int shift = 0; shift < 8; shift++) {
+        unsigned char *input = buffer + shift;
+        for (int at = 0; at < 64; at++) {
+            for (int second = 0; second < 3; second++) {
+                fill(input, RUN_LEN, bytes, count);
+                input[at] = bytes[(at + second) % count];
+                if (second > 0) {
+                    input[at + 16*second + 1] = bytes[second % count];
+                }
+                for (size_t len = RUN_LEN - 40; len <= RUN_LEN; len += 20) {
+                    bool expected = NFA_run(nfa, input, len);
+                    for (int shuffle = 0; shuffle < 2; shuffle++) {
+                        DFA_set_shuffle_kernel(dfa, shuffle);
+                        if (DFA_run(dfa, input, len) != expected) {
+                            wrong++;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    DFA_free(dfa);
+    NFA_free(nfa);
+    return wrong;
+}
+
+int
+main(int argc, char **argv) {
+    srand(1);
+    for (int i = 0; i < NUM_SETS; i++) {
+        const unsigned char *bytes = exitSets[i];
+        int count = exitCounts[i];
+        printf("exit bytes");
+        for (int j = 0; j < count; j++) {
+            printf(" 0x%02x", bytes[j]);
+        }
+        printf("\n");
+        check("searches that disagree", count_wrong_searches(bytes, count), 0);
+        check("runs that disagree", count_wrong_runs(bytes, count, false), 0);
+        check("runs that disagree when stuck", count_wrong_runs(bytes, count, true), 0);
+    }
+    return test_summary();
+}
@@ -0,0 +1,240 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: lazydfa.c
+ *
+ * Cached DFA states are numbered by an IntSetTable over their sets of NFA
+ * states; each one has a row of 256 successors that starts out UNKNOWN and
+ * is filled in as inputs exercise it (DEAD is the empty set).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "lazydfa.h"
+#include "IntSet.h"
+#include "IntSetTable.h"
+
+#define UNKNOWN -2
+#define DEAD -1
+
+typedef struct { //a cached DFA state: its successors, whether it accepts
+                 //and whether it has an absorbing state (so always will)
+    int transition[NFA_NUM_SYMBOLS];
+    bool isAccepting;
+    bool isTrapped;
+} LAZY_STATES;
+
+struct LazyDFA {
+    NFA *nfa;
+    IntSetTable *sets;          //set of NFA states for each cached state
+    LAZY_STATES *stateArray;
+    int capacity;               //allocated length of stateArray
+    size_t budget;
+    size_t used;                //bytes charged for cached states
+    size_t stateCost;           //bytes charged for each cached state
+    int maxFlushes;
+    int flushCount;
+};
+
+/**
+ * Allocate and return a new (empty) lazy DFA cache for the given NFA.
+ */
+extern LazyDFA* LazyDFA_new(NFA* nfa, size_t budget) {
+    LazyDFA *lazy = (LazyDFA*)malloc(sizeof(LazyDFA));
+    if (lazy == NULL) {
+        abort();
+    }
+    lazy->nfa = nfa;
+    lazy->sets = IntSetTable_new();
+    lazy->capacity = 0;
+    lazy->stateArray = NULL;
+    lazy->budget = budget;
+    lazy->used = 0;
+    //a row, its set's bitset and the hash table slots it occupies
+    lazy->stateCost = sizeof(LAZY_STATES)
+        + ((NFA_get_size(nfa) + 63) / 64) * sizeof(unsigned long long)
+        + 4*sizeof(int) + sizeof(IntSet*);
+    lazy->maxFlushes = 8;
+    lazy->flushCount = 0;
+    return lazy;
+}
+
+/**
+ * Free the given lazy DFA and everything it has cached.
+ */
+extern void LazyDFA_free(LazyDFA* lazy) {
+    IntSetTable_free(lazy->sets);
+    free(lazy->stateArray);
+    free(lazy);
+}
+
+extern void LazyDFA_set_flush_limit(LazyDFA* lazy, int maxFlushes) {
+    lazy->maxFlushes = maxFlushes;
+}
+
+/**
+ * Drop every cached state and transition.
+ */
+extern void LazyDFA_flush(LazyDFA* lazy) {
+    IntSetTable_clear(lazy->sets);
+    lazy->used = 0;
+}
+
+extern int LazyDFA_get_size(LazyDFA* lazy) {
+    return IntSetTable_size(lazy->sets);
+}
+
+extern int LazyDFA_get_flush_count(LazyDFA* lazy) {
+    return lazy->flushCount;
+}
+
+//returns the cached state for set (which the cache takes ownership of),
+//adding it with all transitions UNKNOWN if it is new
+static int LazyDFA_add_state(LazyDFA* lazy, IntSet* set) {
+    int before = IntSetTable_size(lazy->sets);
+    int id = IntSetTable_intern(lazy->sets, set);
+    if (id < before) {
+        return id;
+    }
+    if (id == lazy->capacity) {
+        lazy->capacity = lazy->capacity == 0 ? 16 : 2*lazy->capacity;
+        lazy->stateArray = (LAZY_STATES*)realloc(lazy->stateArray,
+                                                 lazy->capacity*sizeof(LAZY_STATES));
+        if (lazy->stateArray == NULL) {
+            abort();
+        }
+    }
+    LAZY_STATES *state = &lazy->stateArray[id];
+    for (int i = 0; i < NFA_NUM_SYMBOLS; i++) {
+        state->transition[i] = UNKNOWN;
+    }
+    state->isAccepting = false;
+    state->isTrapped = IntSet_intersects(IntSetTable_get(lazy->sets, id),
+                                         NFA_get_absorbing_states(lazy->nfa));
+    IntSetIterator *iterator = IntSet_iterator(IntSetTable_get(lazy->sets, id));
+    while (IntSetIterator_has_next(iterator)) {
+        if (NFA_get_accepting(lazy->nfa, IntSetIterator_next(iterator))) {
+            state->isAccepting = true;
+            break;
+        }
+    }
+    free(iterator);
+    lazy->used += lazy->stateCost;
+    return id;
+}
+
+//returns the set of NFA states reached from the given set on sym
+static IntSet* LazyDFA_step(LazyDFA* lazy, const IntSet* from, int sym) {
+    IntSet *next = IntSet_new_with_capacity(NFA_get_size(lazy->nfa));
+    IntSetIterator *iterator = IntSet_iterator(from);
+    while (IntSetIterator_has_next(iterator)) {
+        IntSet_union(next, NFA_get_transitions(lazy->nfa, IntSetIterator_next(iterator), sym));
+    }
+    free(iterator);
+    NFA_close_set(lazy->nfa, next);
+    return next;
+}
+
+//replaces the contents of dst (if not NULL) with those of src
+static void LazyDFA_report(IntSet* dst, const IntSet* src) {
+    if (dst != NULL) {
+        IntSet_clear(dst);
+        IntSet_union(dst, src);
+    }
+}
+
+//finishes a run set-by-set, starting from the given set (which is freed)
+static bool LazyDFA_simulate(LazyDFA* lazy, IntSet* current, IntSet* states,
+                             const unsigned char *input, size_t len) {
+    const IntSet *absorbing = NFA_get_absorbing_states(lazy->nfa);
+    for (size_t i = 0; i < len && !IntSet_is_empty(current)
+             && !IntSet_intersects(current, absorbing); i++) {
+        IntSet *next = LazyDFA_step(lazy, current, input[i]);
+        IntSet_free(current);
+        current = next;
+    }
+    bool accepting = false;
+    IntSetIterator *iterator = IntSet_iterator(current);
+    while (IntSetIterator_has_next(iterator)) {
+        if (NFA_get_accepting(lazy->nfa, IntSetIterator_next(iterator))) {
+            accepting = true;
+            break;
+        }
+    }
+    free(iterator);
+    LazyDFA_report(states, current);
+    IntSet_free(current);
+    return accepting;
+}
+
+//runs from the given set of NFA states (the start set if states is NULL), and
+//leaves the set reached in states
+static bool LazyDFA_run_set(LazyDFA* lazy, IntSet* states,
+                            const unsigned char *input, size_t len) {
+    int flushes = 0;
+    IntSet *start;
+    if (states == NULL) {
+        start = NFA_start_set(lazy->nfa);
+    } else {
+        start = IntSet_new_with_capacity(NFA_get_size(lazy->nfa));
+        IntSet_union(start, states);
+    }
+    if (IntSet_is_empty(start)) {
+        IntSet_free(start);
+        return false;
+    }
+    int current = LazyDFA_add_state(lazy, start);
+    for (size_t i = 0; i < len && !lazy->stateArray[current].isTrapped; i++) {
+        int next = lazy->stateArray[current].transition[input[i]];
+        if (next == UNKNOWN) {
+            IntSet *set = LazyDFA_step(lazy, IntSetTable_get(lazy->sets, current), input[i]);
+            if (IntSet_is_empty(set)) {
+                IntSet_free(set);
+                next = DEAD;
+            } else if (IntSetTable_lookup(lazy->sets, set) < 0
+                       && lazy->used + lazy->stateCost > lazy->budget) {
+                //over budget: start over with an empty cache
+                LazyDFA_flush(lazy);
+                lazy->flushCount++;
+                flushes++;
+                if (lazy->maxFlushes >= 0 && flushes > lazy->maxFlushes) {
+                    return LazyDFA_simulate(lazy, set, states, input + i + 1, len - i - 1);
+                }
+                current = LazyDFA_add_state(lazy, set);
+                continue;
+            } else {
+                next = LazyDFA_add_state(lazy, set);
+            }
+            lazy->stateArray[current].transition[input[i]] = next;
+        }
+        if (next == DEAD) {
+            if (states != NULL) {
+                IntSet_clear(states);
+            }
+            return false;
+        }
+        current = next;
+    }
+    LazyDFA_report(states, IntSetTable_get(lazy->sets, current));
+    return lazy->stateArray[current].isAccepting;
+}
+
+/**
+ * Run the NFA on the len bytes at input using (and filling) the cache.
+ */
+extern bool LazyDFA_run(LazyDFA* lazy, const unsigned char *input, size_t len) {
+    return LazyDFA_run_set(lazy, NULL, input, len);
+}
+
+/**
+ * Run the NFA on the len bytes at input starting from the given set of
+ * NFA states, and replace the contents of that set with the states reached.
+ */
+extern bool LazyDFA_run_from(LazyDFA* lazy, IntSet* states,
+                             const unsigned char *input, size_t len) {
+    return LazyDFA_run_set(lazy, states, input, len);
+}
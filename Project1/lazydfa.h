@@ -0,0 +1,80 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: lazydfa.h
+ *
+ * On-demand subset construction for running an NFA: DFA states (sets of
+ * NFA states) and their transitions are computed the first time they are
+ * needed and cached, so repeated inputs walk a transition table instead
+ * of rebuilding IntSets for every character.
+ */
+
+#ifndef _lazydfa_h
+#define _lazydfa_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "nfa.h"
+#include "IntSet.h"
+
+// Partial declaration
+typedef struct LazyDFA LazyDFA;
+
+/**
+ * Allocate and return a new (empty) lazy DFA cache for the given NFA that
+ * uses at most budget bytes for cached states. The NFA must not be
+ * modified while the cache is in use (nfa.c drops its cache when it is).
+ */
+extern LazyDFA* LazyDFA_new(NFA* nfa, size_t budget);
+
+/**
+ * Free the given lazy DFA and everything it has cached.
+ */
+extern void LazyDFA_free(LazyDFA* lazy);
+
+/**
+ * Set the flush policy: when adding a state would exceed the budget the
+ * whole cache is flushed and the run continues from the current state.
+ * If a single run flushes more than maxFlushes times the cache is
+ * thrashing, and the rest of that input is simulated set-by-set instead.
+ * The default is 8; a negative value never gives up on the cache.
+ */
+extern void LazyDFA_set_flush_limit(LazyDFA* lazy, int maxFlushes);
+
+/**
+ * Drop every cached state and transition.
+ */
+extern void LazyDFA_flush(LazyDFA* lazy);
+
+/**
+ * Return the number of DFA states currently cached.
+ */
+extern int LazyDFA_get_size(LazyDFA* lazy);
+
+/**
+ * Return the number of times the cache has been flushed because it was
+ * over budget.
+ */
+extern int LazyDFA_get_flush_count(LazyDFA* lazy);
+
+/**
+ * Run the NFA on the len bytes at input using (and filling) the cache,
+ * and return true if it accepts them, otherwise false.
+ */
+extern bool LazyDFA_run(LazyDFA* lazy, const unsigned char *input, size_t len);
+
+/**
+ * Run the NFA on the len bytes at input starting from the given set of
+ * NFA states instead of the start set, and replace the contents of that set with
+ * the states reached (empty once no input can be accepted). Returns true
+ * if that set contains an accepting state. This lets a run be split
+ * across several pieces of input.
+ */
+extern bool LazyDFA_run_from(LazyDFA* lazy, IntSet* states,
+                             const unsigned char *input, size_t len);
+
+#endif
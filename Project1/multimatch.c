@@ -0,0 +1,444 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: multimatch.c
+ *
+ * Each added automaton is copied into one growing list of edges, with its
+ * states numbered after those of the automata added before it. Compiling
+ * builds an NFA from the list whose state 0 has an epsilon transition to
+ * the start state of every pattern. Edges into a pattern's absorbing
+ * states (accepting states it can never leave) are redirected to one
+ * "latch" state per pattern that has no transitions out, so it is only
+ * active for the one step in which the pattern gets there.
+ *
+ * The NFA is determinized, and each DFA state is tagged with the pair of
+ * pattern sets it stands for: those latched on entering it and those
+ * accepting if the input ends there. Minimizing keeps different tags
+ * apart. The result is copied to a table like the one DFA_finalize builds,
+ * with rows of latching states last, so a run only does more than one
+ * load per byte when a pattern latches or the DFA gets stuck.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "IntSet.h"
+#include "IntSetTable.h"
+#include "nfa.h"
+#include "dfa.h"
+#include "nfatodfa.h"
+#include "dfamin.h"
+#include "regexnfa.h"
+#include "multimatch.h"
+
+//the symbol of an epsilon edge
+#define MULTI_EPSILON -1
+
+typedef struct { //one transition of one of the added automata
+    int src;
+    int dst;
+    int sym;    //a byte, or MULTI_EPSILON
+} MULTI_EDGE;
+
+struct MultiMatcher {
+    int numOfPatterns;
+    int *startOf;          //pattern -> its start state, or -1 if it has none
+    int numOfStates;       //states of all the patterns, plus state 0
+    int *patternOf;        //state -> the pattern it belongs to
+    bool *accepting;       //for each state
+    bool *absorbing;       //for each state: accepting, and never left
+    MULTI_EDGE *edges;
+    size_t numOfEdges;
+    size_t edgeCapacity;
+    //the compiled DFA, with row offsets into table as in dfa.c: row 0 is
+    //dead, and rows from firstLatching on latch some pattern on entry
+    bool isCompiled;
+    unsigned char classMap[256];
+    int numOfClasses;
+    int numOfRows;
+    uint32_t *table;
+    size_t start;
+    size_t firstLatching;
+    int *latchedOf;        //row -> number of its set of latched patterns
+    int *acceptedOf;       //row -> number of its set of accepting patterns
+    IntSetTable *sets;     //pattern sets, set 0 being the empty one
+};
+
+//reallocs ptr to hold count elements of the given size, aborting if
+//there is not enough memory
+static void *multi_grow(void *ptr, size_t count, size_t size) {
+    ptr = realloc(ptr, (count > 0 ? count : 1) * size);
+    if (ptr == NULL) {
+        abort();
+    }
+    return ptr;
+}
+
+/**
+ * Allocate and return a new MultiMatcher without any patterns.
+ */
+extern MultiMatcher* MultiMatcher_new() {
+    MultiMatcher *matcher = (MultiMatcher *)malloc(sizeof(MultiMatcher));
+    if (matcher == NULL) {
+        abort();
+    }
+    matcher->numOfPatterns = 0;
+    matcher->startOf = NULL;
+    matcher->numOfStates = 1;
+    matcher->patternOf = (int *)multi_grow(NULL, 1, sizeof(int));
+    matcher->accepting = (bool *)multi_grow(NULL, 1, sizeof(bool));
+    matcher->absorbing = (bool *)multi_grow(NULL, 1, sizeof(bool));
+    matcher->patternOf[0] = -1;
+    matcher->accepting[0] = false;
+    matcher->absorbing[0] = false;
+    matcher->edges = NULL;
+    matcher->numOfEdges = 0;
+    matcher->edgeCapacity = 0;
+    matcher->isCompiled = false;
+    matcher->table = NULL;
+    matcher->latchedOf = NULL;
+    matcher->acceptedOf = NULL;
+    matcher->sets = NULL;
+    return matcher;
+}
+
+//drops the compiled DFA, since the patterns have changed
+static void MultiMatcher_drop_compiled(MultiMatcher* matcher) {
+    free(matcher->table);
+    free(matcher->latchedOf);
+    free(matcher->acceptedOf);
+    if (matcher->sets != NULL) {
+        IntSetTable_free(matcher->sets);
+    }
+    matcher->table = NULL;
+    matcher->latchedOf = NULL;
+    matcher->acceptedOf = NULL;
+    matcher->sets = NULL;
+    matcher->isCompiled = false;
+}
+
+/**
+ * Free the given MultiMatcher.
+ */
+extern void MultiMatcher_free(MultiMatcher* matcher) {
+    MultiMatcher_drop_compiled(matcher);
+    free(matcher->startOf);
+    free(matcher->patternOf);
+    free(matcher->accepting);
+    free(matcher->absorbing);
+    free(matcher->edges);
+    free(matcher);
+}
+
+//adds a new pattern with nstates states (none accepting yet), and
+//returns the number of its first state
+static int MultiMatcher_add_states(MultiMatcher* matcher, int nstates) {
+    MultiMatcher_drop_compiled(matcher);
+    int first = matcher->numOfStates;
+    int pattern = matcher->numOfPatterns++;
+    matcher->startOf = (int *)multi_grow(matcher->startOf, matcher->numOfPatterns, sizeof(int));
+    matcher->startOf[pattern] = nstates > 0 ? first : -1;
+    matcher->numOfStates += nstates;
+    matcher->patternOf = (int *)multi_grow(matcher->patternOf, matcher->numOfStates, sizeof(int));
+    matcher->accepting = (bool *)multi_grow(matcher->accepting, matcher->numOfStates, sizeof(bool));
+    matcher->absorbing = (bool *)multi_grow(matcher->absorbing, matcher->numOfStates, sizeof(bool));
+    for (int s = first; s < matcher->numOfStates; s++) {
+        matcher->patternOf[s] = pattern;
+        matcher->accepting[s] = false;
+        matcher->absorbing[s] = false;
+    }
+    return first;
+}
+
+//adds an edge from src to dst on sym (a byte or MULTI_EPSILON)
+static void MultiMatcher_add_edge(MultiMatcher* matcher, int src, int sym, int dst) {
+    if (matcher->numOfEdges == matcher->edgeCapacity) {
+        matcher->edgeCapacity = matcher->edgeCapacity == 0 ? 256 : 2*matcher->edgeCapacity;
+        matcher->edges = (MULTI_EDGE *)multi_grow(matcher->edges, matcher->edgeCapacity, sizeof(MULTI_EDGE));
+    }
+    MULTI_EDGE *edge = &matcher->edges[matcher->numOfEdges++];
+    edge->src = src;
+    edge->dst = dst;
+    edge->sym = sym;
+}
+
+/**
+ * Add a copy of the given NFA to the matcher and return its pattern id.
+ */
+extern int MultiMatcher_add_nfa(MultiMatcher* matcher, NFA* nfa) {
+    int nstates = NFA_get_size(nfa);
+    int first = MultiMatcher_add_states(matcher, nstates);
+    bool hasEpsilon = NFA_has_epsilon_transitions(nfa);
+    const IntSet *absorbing = NFA_get_absorbing_states(nfa);
+    for (int s = 0; s < nstates; s++) {
+        matcher->accepting[first + s] = NFA_get_accepting(nfa, s);
+        matcher->absorbing[first + s] = IntSet_contains(absorbing, s);
+        for (int sym = 0; sym < NFA_NUM_SYMBOLS; sym++) {
+            IntSet *successors = NFA_get_transitions(nfa, s, sym);
+            if (IntSet_is_empty(successors)) {
+                continue;
+            }
+            IntSetIterator *iterator = IntSet_iterator(successors);
+            while (IntSetIterator_has_next(iterator)) {
+                MultiMatcher_add_edge(matcher, first + s, sym, first + IntSetIterator_next(iterator));
+            }
+            free(iterator);
+        }
+        if (hasEpsilon) {
+            //the closure stands in for the epsilon transitions themselves
+            IntSetIterator *iterator = IntSet_iterator(NFA_get_epsilon_closure(nfa, s));
+            while (IntSetIterator_has_next(iterator)) {
+                int dst = IntSetIterator_next(iterator);
+                if (dst != s) {
+                    MultiMatcher_add_edge(matcher, first + s, MULTI_EPSILON, first + dst);
+                }
+            }
+            free(iterator);
+        }
+    }
+    return matcher->numOfPatterns - 1;
+}
+
+/**
+ * Add a copy of the given DFA to the matcher and return its pattern id.
+ */
+extern int MultiMatcher_add_dfa(MultiMatcher* matcher, DFA* dfa) {
+    int nstates = DFA_get_size(dfa);
+    int first = MultiMatcher_add_states(matcher, nstates);
+    for (int s = 0; s < nstates; s++) {
+        bool stays = true;
+        for (int sym = 0; sym < DFA_NUM_SYMBOLS; sym++) {
+            int dst = DFA_get_transition(dfa, s, sym);
+            if (dst >= 0) {
+                MultiMatcher_add_edge(matcher, first + s, sym, first + dst);
+            }
+            stays = stays && dst == s;
+        }
+        matcher->accepting[first + s] = DFA_get_accepting(dfa, s);
+        matcher->absorbing[first + s] = stays && DFA_get_accepting(dfa, s);
+    }
+    return matcher->numOfPatterns - 1;
+}
+
+/**
+ * Compile the given regular expression and add it to the matcher.
+ */
+extern int MultiMatcher_add_regex(MultiMatcher* matcher, const char *pattern, const char **error) {
+    NFA *nfa = regex_to_nfa(pattern, error);
+    if (nfa == NULL) {
+        return -1;
+    }
+    int id = MultiMatcher_add_nfa(matcher, nfa);
+    NFA_free(nfa);
+    return id;
+}
+
+/**
+ * Return the number of patterns added to the given matcher.
+ */
+extern int MultiMatcher_get_num_patterns(const MultiMatcher* matcher) {
+    return matcher->numOfPatterns;
+}
+
+//builds the NFA of all the patterns, with the latch state of pattern p
+//numbered numOfStates + p
+static NFA* MultiMatcher_build_nfa(MultiMatcher* matcher) {
+    int latch = matcher->numOfStates;
+    NFA *nfa = NFA_new(latch + matcher->numOfPatterns);
+    for (int p = 0; p < matcher->numOfPatterns; p++) {
+        int start = matcher->startOf[p];
+        if (start >= 0) {
+            NFA_add_epsilon_transition(nfa, 0, matcher->absorbing[start] ? latch + p : start);
+        }
+    }
+    for (size_t i = 0; i < matcher->numOfEdges; i++) {
+        const MULTI_EDGE *edge = &matcher->edges[i];
+        if (matcher->absorbing[edge->src]) {
+            continue;   //only ever entered through the latch state
+        }
+        int dst = matcher->absorbing[edge->dst] ? latch + matcher->patternOf[edge->dst] : edge->dst;
+        if (edge->sym == MULTI_EPSILON) {
+            NFA_add_epsilon_transition(nfa, edge->src, dst);
+        } else {
+            NFA_add_transition(nfa, edge->src, (char)edge->sym, dst);
+        }
+    }
+    for (int s = 0; s < latch; s++) {
+        if (matcher->accepting[s] && !matcher->absorbing[s]) {
+            NFA_set_accepting(nfa, s, true);
+        }
+    }
+    return nfa;
+}
+
+//tags every state of the given subset DFA with the number in pairs of the
+//set holding the patterns it latches (as p) and accepts (as numOfPatterns + p)
+static void MultiMatcher_tag_states(MultiMatcher* matcher, DFA* dfa, IntSetTable *subsets,
+                                    IntSetTable *pairs) {
+    int k = matcher->numOfPatterns;
+    int latch = matcher->numOfStates;
+    IntSetTable_intern(pairs, IntSet_new_with_capacity(2*k));
+    for (int state = 0; state < DFA_get_size(dfa); state++) {
+        IntSet *pair = IntSet_new_with_capacity(2*k);
+        IntSetIterator *iterator = IntSet_iterator(IntSetTable_get(subsets, state));
+        while (IntSetIterator_has_next(iterator)) {
+            int s = IntSetIterator_next(iterator);
+            if (s >= latch) {
+                IntSet_add(pair, s - latch);
+            } else if (matcher->accepting[s]) {
+                IntSet_add(pair, k + matcher->patternOf[s]);
+            }
+        }
+        free(iterator);
+        int id = IntSetTable_intern(pairs, pair);
+        if (id != 0) {
+            DFA_set_tag(dfa, state, id);
+        }
+    }
+}
+
+//returns the number in matcher->sets of the half of the given pair that
+//starts at first
+static int MultiMatcher_intern_half(MultiMatcher* matcher, const IntSet *pair, int first) {
+    int k = matcher->numOfPatterns;
+    IntSet *set = IntSet_new_with_capacity(k);
+    for (int p = 0; p < k; p++) {
+        if (IntSet_contains(pair, first + p)) {
+            IntSet_add(set, p);
+        }
+    }
+    return IntSetTable_intern(matcher->sets, set);
+}
+
+/**
+ * Build the combined DFA of all the patterns added so far.
+ */
+extern void MultiMatcher_compile(MultiMatcher* matcher) {
+    MultiMatcher_drop_compiled(matcher);
+    NFA *nfa = MultiMatcher_build_nfa(matcher);
+    IntSetTable *subsets;
+    DFA *dfa = nfa_to_dfa_with_sets(nfa, &subsets);
+    NFA_free(nfa);
+    IntSetTable *pairs = IntSetTable_new();
+    MultiMatcher_tag_states(matcher, dfa, subsets, pairs);
+    IntSetTable_free(subsets);
+    DFA *min = DFA_minimize(dfa, NULL);
+    DFA_free(dfa);
+    int n = DFA_get_size(min);
+
+    //the sets each state latches and accepts
+    matcher->sets = IntSetTable_new();
+    IntSetTable_intern(matcher->sets, IntSet_new_with_capacity(matcher->numOfPatterns));
+    int *latched = (int *)multi_grow(NULL, n, sizeof(int));
+    int *accepted = (int *)multi_grow(NULL, n, sizeof(int));
+    for (int s = 0; s < n; s++) {
+        const IntSet *pair = IntSetTable_get(pairs, DFA_get_tag(min, s));
+        latched[s] = MultiMatcher_intern_half(matcher, pair, 0);
+        accepted[s] = MultiMatcher_intern_half(matcher, pair, matcher->numOfPatterns);
+    }
+    IntSetTable_free(pairs);
+
+    //group bytes whose columns agree in every state
+    int representative[256];
+    int numOfClasses = 0;
+    for (int b = 0; b < 256; b++) {
+        int class = -1;
+        for (int c = 0; c < numOfClasses && class < 0; c++) {
+            bool same = true;
+            for (int s = 0; s < n && same; s++) {
+                same = DFA_get_transition(min, s, b) == DFA_get_transition(min, s, representative[c]);
+            }
+            if (same) {
+                class = c;
+            }
+        }
+        if (class < 0) {
+            class = numOfClasses++;
+            representative[class] = b;
+        }
+        matcher->classMap[b] = class;
+    }
+
+    //number the rows: dead, then the states that latch nothing, then the rest
+    int *rowOf = (int *)multi_grow(NULL, n, sizeof(int));
+    int *stateOf = (int *)multi_grow(NULL, n + 1, sizeof(int));
+    int row = 0;
+    stateOf[row++] = -1;
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 1) {
+            matcher->firstLatching = (size_t)row*numOfClasses;
+        }
+        for (int s = 0; s < n; s++) {
+            if ((latched[s] != 0) == (pass == 1)) {
+                rowOf[s] = row;
+                stateOf[row++] = s;
+            }
+        }
+    }
+    if ((size_t)row*numOfClasses > UINT32_MAX) {
+        abort();
+    }
+    matcher->numOfClasses = numOfClasses;
+    matcher->numOfRows = row;
+    matcher->table = (uint32_t *)multi_grow(NULL, (size_t)row*numOfClasses, sizeof(uint32_t));
+    matcher->latchedOf = (int *)multi_grow(NULL, row, sizeof(int));
+    matcher->acceptedOf = (int *)multi_grow(NULL, row, sizeof(int));
+    for (int r = 0; r < row; r++) {
+        int s = stateOf[r];
+        matcher->latchedOf[r] = s < 0 ? 0 : latched[s];
+        matcher->acceptedOf[r] = s < 0 ? 0 : accepted[s];
+        for (int c = 0; c < numOfClasses; c++) {
+            int next = s < 0 ? -1 : DFA_get_transition(min, s, representative[c]);
+            matcher->table[(size_t)r*numOfClasses + c] = next < 0 ? 0 : (uint32_t)rowOf[next]*numOfClasses;
+        }
+    }
+    matcher->start = n > 0 ? (size_t)rowOf[0]*numOfClasses : 0;
+    free(rowOf);
+    free(stateOf);
+    free(latched);
+    free(accepted);
+    DFA_free(min);
+    matcher->isCompiled = true;
+}
+
+/**
+ * Return the number of states of the combined DFA.
+ */
+extern int MultiMatcher_get_size(MultiMatcher* matcher) {
+    if (!matcher->isCompiled) {
+        MultiMatcher_compile(matcher);
+    }
+    return matcher->numOfRows - 1;
+}
+
+/**
+ * Set matched to the ids of the patterns that accept the given input.
+ */
+extern void MultiMatcher_run(const MultiMatcher* matcher, const unsigned char *input, size_t len,
+                             IntSet* matched) {
+    IntSet_clear(matched);
+    if (!matcher->isCompiled) {
+        return;
+    }
+    const uint32_t *table = matcher->table;
+    const unsigned char *classMap = matcher->classMap;
+    size_t numOfClasses = matcher->numOfClasses;
+    size_t lastQuiet = matcher->firstLatching - 1;
+    size_t id = matcher->start;
+    IntSet_union(matched, IntSetTable_get(matcher->sets, matcher->latchedOf[id / numOfClasses]));
+    for (size_t i = 0; i < len; i++) {
+        id = table[id + classMap[input[i]]];
+        if (id - 1 >= lastQuiet) {  //dead (0 wraps around) or latching
+            if (id == 0) {
+                break;
+            }
+            IntSet_union(matched, IntSetTable_get(matcher->sets, matcher->latchedOf[id / numOfClasses]));
+        }
+    }
+    IntSet_union(matched, IntSetTable_get(matcher->sets, matcher->acceptedOf[id / numOfClasses]));
+}
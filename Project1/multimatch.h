@@ -0,0 +1,90 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: multimatch.h
+ *
+ * Running many automata over the same input at once. Each added NFA, DFA
+ * or regular expression gets a pattern id (0, 1, 2, ... in the order they
+ * were added); MultiMatcher_compile unions them all into one minimized
+ * DFA, so one pass over an input finds every pattern that accepts it,
+ * however many there are.
+ *
+ * Once a pattern reaches an accepting state that it can never leave (as
+ * an unanchored regular expression does as soon as it has matched), it
+ * accepts whatever follows, so the DFA only notes it as matched at that
+ * point and forgets its states. That keeps the DFA from having to count
+ * every combination of patterns that have already matched.
+ */
+
+#ifndef _multimatch_h
+#define _multimatch_h
+
+#include <stddef.h>
+#include "IntSet.h"
+#include "nfa.h"
+#include "dfa.h"
+
+// Partial declaration
+typedef struct MultiMatcher MultiMatcher;
+
+/**
+ * Allocate and return a new MultiMatcher without any patterns.
+ */
+extern MultiMatcher* MultiMatcher_new();
+
+/**
+ * Free the given MultiMatcher.
+ */
+extern void MultiMatcher_free(MultiMatcher* matcher);
+
+/**
+ * Add the given NFA to the matcher and return its pattern id. The NFA is
+ * copied, so it can be changed or freed afterwards.
+ */
+extern int MultiMatcher_add_nfa(MultiMatcher* matcher, NFA* nfa);
+
+/**
+ * Add the given DFA to the matcher and return its pattern id. The DFA is
+ * copied, so it can be changed or freed afterwards.
+ */
+extern int MultiMatcher_add_dfa(MultiMatcher* matcher, DFA* dfa);
+
+/**
+ * Compile the given regular expression (see regexnfa.h), add it to the
+ * matcher and return its pattern id. On a syntax error, return -1 and,
+ * if error is not NULL, set *error to a (static) message.
+ */
+extern int MultiMatcher_add_regex(MultiMatcher* matcher, const char *pattern, const char **error);
+
+/**
+ * Return the number of patterns added to the given matcher.
+ */
+extern int MultiMatcher_get_num_patterns(const MultiMatcher* matcher);
+
+/**
+ * Build the combined DFA. Call this after adding the last pattern and
+ * before MultiMatcher_run; adding another pattern means calling it again.
+ */
+extern void MultiMatcher_compile(MultiMatcher* matcher);
+
+/**
+ * Return the number of states of the combined DFA (compiling it if
+ * necessary), not counting the dead state.
+ */
+extern int MultiMatcher_get_size(MultiMatcher* matcher);
+
+/**
+ * Run every pattern of the given compiled matcher on the len bytes at
+ * input, and set matched to the ids of the patterns that accept them
+ * (matched is cleared first). Only reads the matcher, so one compiled
+ * matcher can be shared by several threads. If the matcher has not been
+ * compiled since its last pattern was added, matched is left empty.
+ */
+extern void MultiMatcher_run(const MultiMatcher* matcher, const unsigned char *input, size_t len,
+                             IntSet* matched);
+
+#endif
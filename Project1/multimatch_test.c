@@ -0,0 +1,94 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: multimatch_test.c
+ *
+ * Test program for running many patterns at once with a MultiMatcher:
+ * patterns that latch once they have matched, patterns that only accept
+ * at the end of the input, and running before the matcher is compiled.
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include "IntSet.h"
+#include "dfa.h"
+#include "multimatch.h"
+#include "test_util.h"
+
+//runs the matcher on the given string and checks the ids it reports,
+//where expected lists them in increasing order like "0 2" (empty if none)
+static void check_run(MultiMatcher* matcher, const char *input, const char *expected) {
+    IntSet *matched = IntSet_new();
+    MultiMatcher_run(matcher, (const unsigned char *)input, strlen(input), matched);
+    char got[128] = "";
+    for (int id = 0; id < MultiMatcher_get_num_patterns(matcher); id++) {
+        if (IntSet_contains(matched, id)) {
+            size_t used = strlen(got);
+            snprintf(got + used, sizeof(got) - used, "%s%d", used > 0 ? " " : "", id);
+        }
+    }
+    printf("patterns matching \"%s\" = %s\n", input, got);
+    if (strcmp(got, expected) != 0) {
+        printf("  FAILED: expected %s\n", expected);
+        test_failures++;
+    }
+    IntSet_free(matched);
+}
+
+int
+main(int argc, char **argv) {
+    MultiMatcher *matcher = MultiMatcher_new();
+    MultiMatcher_add_regex(matcher, "code", NULL);
+    MultiMatcher_add_regex(matcher, "man$", NULL);
+    MultiMatcher_add_regex(matcher, "^ab", NULL);
+    DFA *ab = problem_1_a_dfa();
+    MultiMatcher_add_dfa(matcher, ab);
+    DFA_free(ab);
+    const char *error = NULL;
+    int id = MultiMatcher_add_regex(matcher, "(ab", &error);
+    printf("adding (ab gives %d: %s\n", id, error != NULL ? error : "(none)");
+    if (id != -1) {
+        printf("  FAILED: expected -1\n");
+        test_failures++;
+    }
+
+    printf("before compiling\n");
+    check_run(matcher, "abcode", "");
+
+    printf("after compiling\n");
+    MultiMatcher_compile(matcher);
+    check_run(matcher, "", "");
+    check_run(matcher, "ab", "2 3");
+    check_run(matcher, "abc", "2");
+    check_run(matcher, "abcode", "0 2");
+    check_run(matcher, "xcodex", "0");
+    check_run(matcher, "codeman", "0 1");
+    check_run(matcher, "mango", "");
+    check_run(matcher, "abmanx", "2");
+    check_run(matcher, "abman", "1 2");
+
+    printf("latching and then getting stuck\n");
+    MultiMatcher *latch = MultiMatcher_new();
+    MultiMatcher_add_regex(latch, "^ab", NULL);
+    MultiMatcher_add_regex(latch, "^abd$", NULL);
+    MultiMatcher_compile(latch);
+    check_run(latch, "abxxxxxxxx", "0");
+    check_run(latch, "abd", "0 1");
+    check_run(latch, "abdd", "0");
+    check_run(latch, "xab", "");
+    MultiMatcher_free(latch);
+
+    printf("adding a pattern after compiling\n");
+    MultiMatcher_add_regex(matcher, "x+", NULL);
+    check_run(matcher, "abx", "");
+    printf("combined DFA has %d states\n", MultiMatcher_get_size(matcher));
+    check_run(matcher, "abx", "2 4");
+    MultiMatcher_free(matcher);
+
+    return test_summary();
+}
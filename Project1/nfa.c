@@ -4,30 +4,39 @@
  * Net ID: skaveti, rracico3, bneupane
  */
 
-#ifndef _nfa_h
-#define _nfa_h
-
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
 #include "IntSet.h"
 #include "nfa.h"
-
-typedef struct{ //creates NFA_STATES struct with transitions for 128 characters
-                //with a boolean for whether or not it is an accepting state
-    IntSet* transition[128];
+#include "lazydfa.h"
+#include "nfabits.h"
+
+typedef struct{ //creates NFA_STATES struct with transitions for every byte value
+                //with a boolean for whether or not it is an accepting state;
+                //a set is only allocated once a transition is added on it
+    IntSet* transition[NFA_NUM_SYMBOLS];
+    IntSet* epsilon;    //states entered along with this one, or NULL
     bool isAccepting;
 } NFA_STATES;
 
-typedef struct{ //creates NFA struct with # of states, # of accepting states,
-                //current states, accepting states, and state array
+struct NFA { //creates NFA struct with # of states, # of accepting states,
+             //current states, accepting states, and state array
     int numOfStates;
     int numOfAcceptingStates;
     IntSet *currentStates;
     int *acceptingStates;
     NFA_STATES *stateArray;
-} NFA;
+    NFA_BACKEND backend; //how NFA_execute runs the NFA
+    size_t cacheBudget;  //memory for the lazy DFA backend
+    LazyDFA *cache;      //backend tables are created on first use and
+    BitNFA *bits;        //dropped when the NFA changes
+    IntSet *absorbing;   //likewise for NFA_get_absorbing_states
+    IntSet **closures;   //and for each state's epsilon-closure
+    bool hasEpsilon;
+    IntSet *noTransitions; //empty set standing in for unallocated ones
+};
 
 /**
  * Allocate and return a new NFA containing the given number of states.
@@ -35,9 +44,16 @@ typedef struct{ //creates NFA struct with # of states, # of accepting states,
 extern NFA* NFA_new(int nstates){
     NFA *nfa = (NFA*)malloc(sizeof(NFA));
     nfa->numOfStates = nstates;
-    nfa->currentStates = IntSet_new();
+    nfa->currentStates = IntSet_new_with_capacity(nstates);
     IntSet_add(nfa->currentStates, 0);
     nfa->numOfAcceptingStates = 0;
+    nfa->backend = NFA_BACKEND_SETS;
+    nfa->cacheBudget = 1 << 20;
+    nfa->cache = NULL;
+    nfa->bits = NULL;
+    nfa->absorbing = NULL;
+    nfa->closures = NULL;
+    nfa->hasEpsilon = false;
     nfa->stateArray = (NFA_STATES *)malloc(nstates*sizeof(NFA_STATES));
     nfa->acceptingStates = (int *)malloc(nstates*sizeof(int));
     for(int i = 0; i < nstates; i++){
@@ -45,27 +61,94 @@ extern NFA* NFA_new(int nstates){
     }
     for (int i = 0; i < nstates; i++) {
         nfa->stateArray[i].isAccepting = false;
+        nfa->stateArray[i].epsilon = NULL;
     }
     for (int i = 0; i < nstates; i++) {
-        for (int j = 0; j < 128; j++) {
-            nfa->stateArray[i].transition[j] = IntSet_new();
+        for (int j = 0; j < NFA_NUM_SYMBOLS; j++) {
+            nfa->stateArray[i].transition[j] = NULL;
         }
     }
+    nfa->noTransitions = IntSet_new();
 
     return nfa;
 }
+//drops the backend tables, since the NFA they were built from has changed
+static void NFA_drop_cache(NFA* nfa) {
+    if (nfa->cache != NULL) {
+        LazyDFA_free(nfa->cache);
+        nfa->cache = NULL;
+    }
+    if (nfa->bits != NULL) {
+        BitNFA_free(nfa->bits);
+        nfa->bits = NULL;
+    }
+    if (nfa->absorbing != NULL) {
+        IntSet_free(nfa->absorbing);
+        nfa->absorbing = NULL;
+    }
+    if (nfa->closures != NULL) {
+        for (int i = 0; i < nfa->numOfStates; i++) {
+            IntSet_free(nfa->closures[i]);
+        }
+        free(nfa->closures);
+        nfa->closures = NULL;
+    }
+}
+
 //frees the given NFA
 extern void NFA_free(NFA* nfa){
   for (int i = 0; i < nfa->numOfStates; i++) {
         NFA_STATES *state = &nfa->stateArray[i];
-        for (int j = 0; j < 128; j++) {
-            IntSet_free(state->transition[j]);
+        for (int j = 0; j < NFA_NUM_SYMBOLS; j++) {
+            if (state->transition[j] != NULL) {
+                IntSet_free(state->transition[j]);
+            }
+        }
+        if (state->epsilon != NULL) {
+            IntSet_free(state->epsilon);
         }
     }
+    IntSet_free(nfa->noTransitions);
     IntSet_free(nfa->currentStates);
+    NFA_drop_cache(nfa);
+    free(nfa->acceptingStates);
     free(nfa->stateArray);
     free(nfa);
 }
+//returns the set of successors of state on sym (which must not be changed)
+static IntSet* NFA_successors(const NFA* nfa, int state, int sym) {
+    IntSet *set = nfa->stateArray[state].transition[sym];
+    return set != NULL ? set : nfa->noTransitions;
+}
+
+//returns the set of successors of src on sym for adding to, allocating it
+//on first use
+static IntSet* NFA_successors_to_add(NFA* nfa, int src, int sym) {
+    IntSet **set = &nfa->stateArray[src].transition[sym];
+    if (*set == NULL) {
+        *set = IntSet_new_with_capacity(nfa->numOfStates);
+    }
+    return *set;
+}
+
+/**
+ * Choose how NFA_execute runs the given NFA.
+ */
+extern void NFA_set_backend(NFA* nfa, NFA_BACKEND backend) {
+    NFA_drop_cache(nfa);
+    nfa->backend = backend;
+}
+
+/**
+ * Use a lazy DFA cache of at most budget bytes in NFA_execute, or go
+ * back to set-by-set simulation if budget is 0.
+ */
+extern void NFA_set_cache_budget(NFA* nfa, size_t budget) {
+    NFA_drop_cache(nfa);
+    nfa->cacheBudget = budget;
+    nfa->backend = budget > 0 ? NFA_BACKEND_LAZY_DFA : NFA_BACKEND_SETS;
+}
+
 /**
  * Return the number of states in the given NFA.
  */
@@ -77,21 +160,23 @@ extern int NFA_get_size(NFA* nfa){
  * function from the given state on input symbol sym.
  */
 extern IntSet* NFA_get_transitions(NFA* nfa, int state, char sym){
-    return nfa->stateArray[state].transition[sym];
+    return NFA_successors(nfa, state, (unsigned char)sym);
 }
 /**
  * For the given NFA, add the state dst to the set of next states from
  * state src on input symbol sym.
  */
 extern void NFA_add_transition(NFA* nfa, int src, char sym, int dst){
-    IntSet_add(nfa->stateArray[src].transition[sym], dst);
+    NFA_drop_cache(nfa);
+    IntSet_add(NFA_successors_to_add(nfa, src, (unsigned char)sym), dst);
 }
 /**
  * Add a transition for the given NFA for each symbol in the given str.
  */
 extern void NFA_add_transition_str(NFA* nfa, int src, char *str, int dst){
+    NFA_drop_cache(nfa);
     for (int i = 0; str[i] != '\0'; i++) {
-        IntSet_add(nfa->stateArray[src].transition[str[i]], dst);
+        IntSet_add(NFA_successors_to_add(nfa, src, (unsigned char)str[i]), dst);
 
     }
 }
@@ -99,16 +184,127 @@ extern void NFA_add_transition_str(NFA* nfa, int src, char *str, int dst){
  * Add a transition for the given NFA for each input symbol.
  */
 extern void NFA_add_transition_all(NFA* nfa, int src, int dst){
+    NFA_drop_cache(nfa);
+    for(int i = 0; i < NFA_NUM_SYMBOLS; i++){
+        IntSet_add(NFA_successors_to_add(nfa, src, i), dst);
+    }
+}
+/**
+ * Add an epsilon transition from state src to state dst, so that dst is
+ * active whenever src is, without reading any input.
+ */
+extern void NFA_add_epsilon_transition(NFA* nfa, int src, int dst){
+    NFA_drop_cache(nfa);
+    if (nfa->stateArray[src].epsilon == NULL) {
+        nfa->stateArray[src].epsilon = IntSet_new_with_capacity(nfa->numOfStates);
+    }
+    IntSet_add(nfa->stateArray[src].epsilon, dst);
+    nfa->hasEpsilon = true;
+}
+
+/**
+ * Return true if the given NFA has any epsilon transitions.
+ */
+extern bool NFA_has_epsilon_transitions(NFA* nfa){
+    return nfa->hasEpsilon;
+}
 
-    for(int i = 0; i < 128; i++){
-        if(IntSet_is_empty(nfa->stateArray[src].transition[i])){
-            nfa->stateArray[src].transition[i] = IntSet_new();
-            IntSet_add(nfa->stateArray[src].transition[i], dst);
-        }else{
-            IntSet_add(nfa->stateArray[src].transition[i], dst);
+//computes every state's epsilon-closure by a depth-first search along the
+//epsilon transitions from it
+static void NFA_compute_closures(NFA* nfa) {
+    int n = nfa->numOfStates;
+    nfa->closures = (IntSet **)malloc(n*sizeof(IntSet *));
+    int *stack = (int *)malloc(n*sizeof(int));
+    if ((nfa->closures == NULL || stack == NULL) && n > 0) {
+        abort();
+    }
+    for (int s = 0; s < n; s++) {
+        IntSet *closure = IntSet_new_with_capacity(n);
+        IntSet_add(closure, s);
+        int top = 0;
+        stack[top++] = s;
+        while (top > 0) {
+            IntSet *epsilon = nfa->stateArray[stack[--top]].epsilon;
+            if (epsilon == NULL) {
+                continue;
+            }
+            IntSetIterator *iterator = IntSet_iterator(epsilon);
+            while (IntSetIterator_has_next(iterator)) {
+                int t = IntSetIterator_next(iterator);
+                if (!IntSet_contains(closure, t)) {
+                    IntSet_add(closure, t);
+                    stack[top++] = t;
+                }
+            }
+            free(iterator);
         }
+        nfa->closures[s] = closure;
     }
+    free(stack);
 }
+
+/**
+ * Return the epsilon-closure of the given state: the states reachable
+ * from it along epsilon transitions alone, including the state itself.
+ */
+extern const IntSet* NFA_get_epsilon_closure(NFA* nfa, int state){
+    if (nfa->closures == NULL) {
+        NFA_compute_closures(nfa);
+    }
+    return nfa->closures[state];
+}
+
+/**
+ * Add the epsilon-closure of each member of the given set to it.
+ */
+extern void NFA_close_set(NFA* nfa, IntSet* set){
+    if (!nfa->hasEpsilon) {
+        return;
+    }
+    //collect into a separate set so the iteration is not disturbed
+    IntSet *closed = IntSet_new_with_capacity(nfa->numOfStates);
+    IntSetIterator *iterator = IntSet_iterator(set);
+    while (IntSetIterator_has_next(iterator)) {
+        IntSet_union(closed, NFA_get_epsilon_closure(nfa, IntSetIterator_next(iterator)));
+    }
+    free(iterator);
+    IntSet_union(set, closed);
+    IntSet_free(closed);
+}
+
+/**
+ * Return a new set holding the states the given NFA starts in: the
+ * epsilon-closure of state 0.
+ */
+extern IntSet* NFA_start_set(NFA* nfa){
+    IntSet *start = IntSet_new_with_capacity(nfa->numOfStates);
+    if (nfa->numOfStates > 0) {
+        IntSet_add(start, 0);
+        NFA_close_set(nfa, start);
+    }
+    return start;
+}
+
+//returns true if state s is still active after reading sym from a set
+//containing it (directly or through epsilon transitions)
+static bool NFA_stays_on(NFA* nfa, int s, int sym) {
+    const IntSet *successors = NFA_successors(nfa, s, sym);
+    if (IntSet_contains(successors, s)) {
+        return true;
+    }
+    if (nfa->hasEpsilon) {
+        IntSetIterator *iterator = IntSet_iterator(successors);
+        while (IntSetIterator_has_next(iterator)) {
+            if (IntSet_contains(NFA_get_epsilon_closure(nfa, IntSetIterator_next(iterator)), s)) {
+                free(iterator);
+                return true;
+            }
+        }
+        free(iterator);
+    }
+    return false;
+}
+
 //checks if a string has a certain character
 extern bool char_check_contains(char* exc, char c) {
     for (int i = 0; exc[i] != '\0'; i++) {
@@ -120,9 +316,10 @@ extern bool char_check_contains(char* exc, char c) {
 }
 //sets transitions on all chars except for specified exceptions
 extern void NFA_set_transition_exception(NFA* nfa, int src, int dst, char* exc) {
-    for (int i = 0; i < 128; i++) {
+    NFA_drop_cache(nfa);
+    for (int i = 0; i < NFA_NUM_SYMBOLS; i++) {
         if (!char_check_contains(exc, i)) {
-            IntSet_add(nfa->stateArray[src].transition[i], dst);
+            IntSet_add(NFA_successors_to_add(nfa, src, i), dst);
         }
     }
 }
@@ -130,11 +327,21 @@ extern void NFA_set_transition_exception(NFA* nfa, int src, int dst, char* exc)
  * Set whether the given NFA's state is accepting or not.
  */
 extern void NFA_set_accepting(NFA* nfa, int state, bool value) {
+    if (nfa->stateArray[state].isAccepting == value) {
+        return;
+    }
+    NFA_drop_cache(nfa);
     nfa->stateArray[state].isAccepting = value;
-    nfa->numOfAcceptingStates++;
+    if (value) {
+        nfa->acceptingStates[nfa->numOfAcceptingStates++] = state;
+        return;
+    }
+    //move the last accepting state into the removed one's place
     for(int i = 0; i < nfa->numOfAcceptingStates; i++){
-        if(nfa->acceptingStates[i] == -1){
-            nfa->acceptingStates[i] = state;
+        if(nfa->acceptingStates[i] == state){
+            nfa->numOfAcceptingStates--;
+            nfa->acceptingStates[i] = nfa->acceptingStates[nfa->numOfAcceptingStates];
+            nfa->acceptingStates[nfa->numOfAcceptingStates] = -1;
             break;
         }
     }
@@ -145,41 +352,77 @@ extern void NFA_set_accepting(NFA* nfa, int state, bool value) {
 extern bool NFA_get_accepting(NFA* nfa, int state) {
     return nfa->stateArray[state].isAccepting;
 }
-//sets the current state
-void NFA_set_current_state(NFA* nfa, int statenum){
-    IntSet *stateSet = IntSet_new();
-    IntSet_add(stateSet, statenum);
-    if (IntSet_is_empty(nfa->currentStates)) {
-
-    };
+/**
+ * Return the set of accepting states of the given NFA that go back to
+ * themselves on every input symbol.
+ */
+extern const IntSet* NFA_get_absorbing_states(NFA* nfa) {
+    if (nfa->absorbing == NULL) {
+        nfa->absorbing = IntSet_new_with_capacity(nfa->numOfStates);
+        for (int s = 0; s < nfa->numOfStates; s++) {
+            bool absorbing = nfa->stateArray[s].isAccepting;
+            for (int i = 0; i < NFA_NUM_SYMBOLS && absorbing; i++) {
+                absorbing = NFA_stays_on(nfa, s, i);
+            }
+            if (absorbing) {
+                IntSet_add(nfa->absorbing, s);
+            }
+        }
+    }
+    return nfa->absorbing;
 }
 
 //gives the set a certain index
 extern IntSet* give_int_set(NFA* nfa, char input, int state) {
-    return nfa->stateArray[state].transition[input];
+    return NFA_successors(nfa, state, (unsigned char)input);
 }
 
 //executes NFA
 extern bool NFA_execute(NFA* nfa, char *input){
-    IntSet* tempSet = IntSet_new();
-    IntSet* beginSet = IntSet_new();
-    IntSet_add(tempSet, 0);
-    IntSet* middleSet;
-    for (int i = 0; input[i] != '\0'; i++) {
-        beginSet = tempSet;
-        IntSetIterator* iterator = IntSet_iterator(beginSet);
-        middleSet = IntSet_new();
+    return NFA_run(nfa, (const unsigned char *)input, strlen(input));
+}
+
+//advances the given set of active states (freeing it) over the len bytes
+//at input set-by-set, and returns the set reached
+static IntSet* NFA_simulate(NFA* nfa, IntSet* tempSet, const unsigned char *input, size_t len){
+    //stop once no state is left, or once an absorbing state is reached
+    const IntSet* absorbing = NFA_get_absorbing_states(nfa);
+    for (size_t i = 0; i < len && !IntSet_is_empty(tempSet)
+             && !IntSet_intersects(tempSet, absorbing); i++) {
+        //union the successors of every active state into a fresh set
+        IntSet* middleSet = IntSet_new_with_capacity(nfa->numOfStates);
+        IntSetIterator* iterator = IntSet_iterator(tempSet);
         while(IntSetIterator_has_next(iterator)) {
             int iteratorFirst = IntSetIterator_next(iterator);
-            tempSet = give_int_set(nfa, input[i], iteratorFirst);
-            IntSet_union(middleSet, tempSet);
-            if (!IntSetIterator_has_next(iterator)) {
-                tempSet = middleSet;
-                break;
-            }
+            IntSet_union(middleSet, NFA_successors(nfa, iteratorFirst, input[i]));
         }
+        free(iterator);
+        NFA_close_set(nfa, middleSet);
+        IntSet_free(tempSet);
+        tempSet = middleSet;
     }
-    nfa->currentStates = tempSet;
+    return tempSet;
+}
+
+/**
+ * Run the given NFA on the len bytes at input, and return true if it
+ * accepts them, otherwise false.
+ */
+extern bool NFA_run(NFA* nfa, const unsigned char *input, size_t len){
+    if (nfa->backend == NFA_BACKEND_LAZY_DFA) {
+        if (nfa->cache == NULL) {
+            nfa->cache = LazyDFA_new(nfa, nfa->cacheBudget);
+        }
+        return LazyDFA_run(nfa->cache, input, len);
+    }
+    if (nfa->backend == NFA_BACKEND_BIT_PARALLEL) {
+        if (nfa->bits == NULL) {
+            nfa->bits = BitNFA_new(nfa);
+        }
+        return BitNFA_run(nfa->bits, input, len);
+    }
+    IntSet_free(nfa->currentStates);
+    nfa->currentStates = NFA_simulate(nfa, NFA_start_set(nfa), input, len);
     for(int i = 0; i < nfa->numOfAcceptingStates; i++){
         if (IntSet_contains(nfa->currentStates, nfa->acceptingStates[i])){
             return true;
@@ -188,31 +431,115 @@ extern bool NFA_execute(NFA* nfa, char *input){
     return false;
 }
 
-//problem 2a
-extern void problem_2_a(){
-    printf("Problem 2a (Strings ending in man)--------------------------------------------\n");
-    printf("Only accepts 64 characters\n");
-    printf("Enter quit to exit the problem\n");
+struct NFA_Cursor { //the NFA being run and the set of its active states
+    NFA *nfa;
+    IntSet *states;
+};
+
+/**
+ * Allocate and return a cursor at the start of a run of the given NFA.
+ */
+extern NFA_Cursor* NFA_Cursor_new(NFA* nfa){
+    NFA_Cursor *cursor = (NFA_Cursor*)malloc(sizeof(NFA_Cursor));
+    if (cursor == NULL) {
+        abort();
+    }
+    cursor->nfa = nfa;
+    cursor->states = NFA_start_set(nfa);
+    return cursor;
+}
+
+/**
+ * Free the given cursor.
+ */
+extern void NFA_Cursor_free(NFA_Cursor* cursor){
+    IntSet_free(cursor->states);
+    free(cursor);
+}
+
+/**
+ * Advance the given cursor over the next len bytes of input.
+ */
+extern void NFA_Cursor_feed(NFA_Cursor* cursor, const unsigned char *input, size_t len){
+    NFA *nfa = cursor->nfa;
+    if (nfa->backend == NFA_BACKEND_LAZY_DFA) {
+        if (nfa->cache == NULL) {
+            nfa->cache = LazyDFA_new(nfa, nfa->cacheBudget);
+        }
+        LazyDFA_run_from(nfa->cache, cursor->states, input, len);
+    } else if (nfa->backend == NFA_BACKEND_BIT_PARALLEL) {
+        if (nfa->bits == NULL) {
+            nfa->bits = BitNFA_new(nfa);
+        }
+        BitNFA_run_from(nfa->bits, cursor->states, input, len);
+    } else {
+        cursor->states = NFA_simulate(nfa, cursor->states, input, len);
+    }
+}
+
+/**
+ * Return true if the input fed to the given cursor so far is accepted.
+ */
+extern bool NFA_Cursor_is_accepting(const NFA_Cursor* cursor){
+    for(int i = 0; i < cursor->nfa->numOfAcceptingStates; i++){
+        if (IntSet_contains(cursor->states, cursor->nfa->acceptingStates[i])){
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Return true if the given cursor has no active states left, so no
+ * further input can make it accept.
+ */
+extern bool NFA_Cursor_is_dead(const NFA_Cursor* cursor){
+    return IntSet_is_empty(cursor->states);
+}
+
+/**
+ * Return true if no further input can change whether the given cursor
+ * accepts.
+ */
+extern bool NFA_Cursor_is_decided(const NFA_Cursor* cursor){
+    return IntSet_is_empty(cursor->states)
+        || IntSet_intersects(cursor->states, NFA_get_absorbing_states(cursor->nfa));
+}
+
+//builds the automaton for problem 2a
+extern NFA* problem_2_a_nfa() {
     NFA* problem2a = NFA_new(4);
     NFA_add_transition(problem2a, 0, 'm', 1);
     NFA_add_transition(problem2a, 1, 'a', 2);
     NFA_add_transition(problem2a, 2, 'n', 3);
     NFA_add_transition_all(problem2a, 0, 0);
     NFA_set_accepting(problem2a, 3, true);
+    NFA_set_backend(problem2a, NFA_BACKEND_BIT_PARALLEL); //one word holds every state
+    return problem2a;
+}
+
+//problem 2a
+extern void problem_2_a(){
+    printf("Problem 2a (Strings ending in man)--------------------------------------------\n");
+    printf("Enter quit to exit the problem\n");
+    NFA* problem2a = problem_2_a_nfa();
 
 //while loop keeps making user enter input until they type quit
+    char *input = NULL;
+    size_t capacity = 0;
     while (1) {
-        NFA_set_current_state(problem2a, 0);
-        char *input = malloc(64*sizeof(char));
         printf("Test: ");
-        scanf("%s", input);
+        ssize_t len = getline(&input, &capacity, stdin);
+        if (len > 0 && input[len-1] == '\n') {
+            input[--len] = '\0';
+        }
 
-        if (strncmp(input, "quit", 4) == 0) {
+        if (len < 0 || strncmp(input, "quit", 4) == 0) {
             printf("Quitting Problem 2a\n");
             break;
         }
 
-        int test = NFA_execute(problem2a, input);
+        int test = NFA_run(problem2a, (unsigned char *)input, len);
         if (test == 0) {
             printf("%s is not accepted\n", input);
         }
@@ -220,16 +547,14 @@ extern void problem_2_a(){
             printf("%s is accepted\n", input);
         }
     }
+    free(input);
     printf("\n");
     NFA_free(problem2a);
 
 }
 
-//problem 2b
-extern void problem_2_b(){
-    printf("Problem 2b (Strings with more than one a, g, h, i, o, s, t, or w, or more than two n’s)--------------------------------------------\n");
-    printf("Only accepts 64 characters\n");
-    printf("Enter quit to exit the problem\n");
+//builds the automaton for problem 2b
+extern NFA* problem_2_b_nfa() {
     NFA* problem2b = NFA_new(20);
 
     NFA_add_transition_all(problem2b, 0, 0);
@@ -290,20 +615,32 @@ extern void problem_2_b(){
     NFA_set_accepting(problem2b, 15, true);
     NFA_set_accepting(problem2b, 17, true);
     NFA_set_accepting(problem2b, 19, true);
+    NFA_set_cache_budget(problem2b, 1 << 20); //reuse DFA states across inputs
+    return problem2b;
+}
+
+//problem 2b
+extern void problem_2_b(){
+    printf("Problem 2b (Strings with more than one a, g, h, i, o, s, t, or w, or more than two n’s)--------------------------------------------\n");
+    printf("Enter quit to exit the problem\n");
+    NFA* problem2b = problem_2_b_nfa();
 
 //while loop keeps making user enter input until they type quit
+    char *input = NULL;
+    size_t capacity = 0;
     while (1) {
-        NFA_set_current_state(problem2b, 0);
-        char *input = malloc(64*sizeof(char));
         printf("Test: ");
-        scanf("%s", input);
+        ssize_t len = getline(&input, &capacity, stdin);
+        if (len > 0 && input[len-1] == '\n') {
+            input[--len] = '\0';
+        }
 
-        if (strncmp(input, "quit", 4) == 0) {
+        if (len < 0 || strncmp(input, "quit", 4) == 0) {
             printf("Quitting Problem 2b\n");
             break;
         }
 
-        int test = NFA_execute(problem2b, input);
+        int test = NFA_run(problem2b, (unsigned char *)input, len);
         if (test == 0) {
             printf("%s is not accepted\n", input);
         }
@@ -311,15 +648,13 @@ extern void problem_2_b(){
             printf("%s is accepted\n", input);
         }
     }
+    free(input);
     NFA_free(problem2b);
     printf("\n");
 
 }
-//problem 2c
-extern void problem_2_c(){
-    printf("Problem 2c (Strings with 'code' anywhere in it)--------------------------------------------\n");
-    printf("Only accepts 64 characters\n");
-    printf("Enter quit to exit the problem\n");
+//builds the automaton for problem 2c
+extern NFA* problem_2_c_nfa() {
     NFA* problem2c = NFA_new(5);
 
     NFA_add_transition_all(problem2c, 0, 0);
@@ -329,20 +664,32 @@ extern void problem_2_c(){
     NFA_add_transition(problem2c, 3, 'e', 4);
     NFA_add_transition_all(problem2c, 4, 4);
     NFA_set_accepting(problem2c, 4, true);
+    NFA_set_backend(problem2c, NFA_BACKEND_BIT_PARALLEL); //one word holds every state
+    return problem2c;
+}
+
+//problem 2c
+extern void problem_2_c(){
+    printf("Problem 2c (Strings with 'code' anywhere in it)--------------------------------------------\n");
+    printf("Enter quit to exit the problem\n");
+    NFA* problem2c = problem_2_c_nfa();
 
 //while loop keeps making user enter input until they type quit
+    char *input = NULL;
+    size_t capacity = 0;
     while (1) {
-        NFA_set_current_state(problem2c, 0);
-        char *input = malloc(64*sizeof(char));
         printf("Test: ");
-        scanf("%s", input);
+        ssize_t len = getline(&input, &capacity, stdin);
+        if (len > 0 && input[len-1] == '\n') {
+            input[--len] = '\0';
+        }
 
-        if (strncmp(input, "quit", 4) == 0) {
+        if (len < 0 || strncmp(input, "quit", 4) == 0) {
             printf("Quitting Problem 2c\n");
             break;
         }
 
-        int test = NFA_execute(problem2c, input);
+        int test = NFA_run(problem2c, (unsigned char *)input, len);
         if (test == 0) {
             printf("%s is not accepted\n", input);
         }
@@ -350,9 +697,8 @@ extern void problem_2_c(){
             printf("%s is accepted\n", input);
         }
     }
+    free(input);
     NFA_free(problem2c);
     printf("\n");
 
 }
-
-#endif
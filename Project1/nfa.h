@@ -15,6 +15,7 @@
 #define _nfa_h
 
 #include <stdbool.h>
+#include <stddef.h>
 #include "IntSet.h"
 
 /**
@@ -22,7 +23,12 @@
  * @see FOCS Section 10.3
  * @see Comments for DFA in dfa.h
  */
-typedef struct NFA *NFA;
+typedef struct NFA NFA;
+
+/**
+ * The number of input symbols: NFAs run over arbitrary bytes.
+ */
+#define NFA_NUM_SYMBOLS 256
 
 /**
  * Allocate and return a new NFA containing the given number of states.
@@ -41,7 +47,8 @@ extern int NFA_get_size(NFA* nfa);
 
 /**
  * Return the set of next states specified by the given NFA's transition
- * function from the given state on input symbol sym.
+ * function from the given state on input symbol sym. The set belongs to
+ * the NFA and must not be changed; use NFA_add_transition instead.
  */
 extern IntSet* NFA_get_transitions(NFA* nfa, int state, char sym);
 
@@ -61,6 +68,37 @@ extern void NFA_add_transition_str(NFA* nfa, int src, char *str, int dst);
  */
 extern void NFA_add_transition_all(NFA* nfa, int src, int dst);
 
+/**
+ * Add an epsilon transition from state src to state dst, so that dst is
+ * active whenever src is, without reading any input.
+ */
+extern void NFA_add_epsilon_transition(NFA* nfa, int src, int dst);
+
+/**
+ * Return true if the given NFA has any epsilon transitions.
+ */
+extern bool NFA_has_epsilon_transitions(NFA* nfa);
+
+/**
+ * Return the epsilon-closure of the given state: the states reachable
+ * from it along epsilon transitions alone, including the state itself.
+ * The closures of all states are computed together on first use and kept
+ * (as bitsets) until the NFA changes; the set must not be changed.
+ */
+extern const IntSet* NFA_get_epsilon_closure(NFA* nfa, int state);
+
+/**
+ * Add the epsilon-closure of each member of the given set to it. Every
+ * way of running an NFA keeps its active set closed like this.
+ */
+extern void NFA_close_set(NFA* nfa, IntSet* set);
+
+/**
+ * Return a new set holding the states the given NFA starts in: the
+ * epsilon-closure of state 0.
+ */
+extern IntSet* NFA_start_set(NFA* nfa);
+
 //checks if a string has a certain character
 extern bool char_check_contains(char* exc, char c);
 
@@ -77,6 +115,40 @@ extern void NFA_set_accepting(NFA* nfa, int state, bool value);
  */
 extern bool NFA_get_accepting(NFA* nfa, int state);
 
+/**
+ * Return the set of accepting states of the given NFA that go back to
+ * themselves on every input symbol: once one of them is active, the input
+ * is accepted whatever follows.
+ */
+extern const IntSet* NFA_get_absorbing_states(NFA* nfa);
+
+/**
+ * The ways NFA_execute can run an NFA.
+ * NFA_BACKEND_SETS simulates it set-by-set with IntSets (the default).
+ * NFA_BACKEND_LAZY_DFA caches the DFA states it discovers (lazydfa.h).
+ * NFA_BACKEND_BIT_PARALLEL advances the active states as bitmasks
+ * (nfabits.h), which is fastest for NFAs of up to 64 states.
+ */
+typedef enum {
+    NFA_BACKEND_SETS,
+    NFA_BACKEND_LAZY_DFA,
+    NFA_BACKEND_BIT_PARALLEL
+} NFA_BACKEND;
+
+/**
+ * Choose how NFA_execute runs the given NFA. Any precomputed tables are
+ * built on the next call and dropped whenever the NFA changes.
+ */
+extern void NFA_set_backend(NFA* nfa, NFA_BACKEND backend);
+
+/**
+ * Make NFA_execute cache the DFA states it discovers (a lazy DFA) using at
+ * most budget bytes, so repeated inputs reuse computed transitions.
+ * A budget of 0 simulates the NFA set-by-set instead.
+ * Changing the NFA drops the cache.
+ */
+extern void NFA_set_cache_budget(NFA* nfa, size_t budget);
+
 /**
  * Run the given NFA on the given input string, and return true if it accepts
  * the input, otherwise false.
@@ -88,10 +160,61 @@ extern IntSet* give_int_set(NFA* nfa, char input, int state);
 //executes NFA
 extern bool NFA_execute(NFA* nfa, char *input);
 
+/**
+ * Run the given NFA on the len bytes at input (any byte values, including
+ * '\0'), and return true if it accepts them, otherwise false.
+ * NFA_execute(nfa, input) is NFA_run on the bytes of a C string.
+ */
+extern bool NFA_run(NFA* nfa, const unsigned char *input, size_t len);
+
+// Partial declaration
+typedef struct NFA_Cursor NFA_Cursor;
+
+/**
+ * Allocate and return a cursor at the start of a run of the given NFA,
+ * for feeding it input a piece at a time. Cursors run each piece with
+ * the NFA's backend (see NFA_set_backend), and only carry the set of
+ * active states between pieces.
+ */
+extern NFA_Cursor* NFA_Cursor_new(NFA* nfa);
+
+/**
+ * Free the given cursor.
+ */
+extern void NFA_Cursor_free(NFA_Cursor* cursor);
+
+/**
+ * Advance the given cursor over the next len bytes of input.
+ */
+extern void NFA_Cursor_feed(NFA_Cursor* cursor, const unsigned char *input, size_t len);
+
+/**
+ * Return true if the input fed to the given cursor so far is accepted.
+ */
+extern bool NFA_Cursor_is_accepting(const NFA_Cursor* cursor);
+
+/**
+ * Return true if the given cursor has no active states left, so no
+ * further input can make it accept. A cursor whose states can only
+ * reach rejecting ones is not dead until it runs out of states.
+ */
+extern bool NFA_Cursor_is_dead(const NFA_Cursor* cursor);
+
+/**
+ * Return true if no further input can change whether the given cursor
+ * accepts: it is dead, or one of its states is absorbing.
+ */
+extern bool NFA_Cursor_is_decided(const NFA_Cursor* cursor);
+
 /**
  * Print the given NFA to System.out.
  */
 
+//builds the NFAs used by the problems below
+extern NFA* problem_2_a_nfa();
+extern NFA* problem_2_b_nfa();
+extern NFA* problem_2_c_nfa();
+
 extern void problem_2_a();
 extern void problem_2_b();
 extern void problem_2_c();
@@ -0,0 +1,200 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: nfa_test.c
+ *
+ * Test program for NFAs with epsilon transitions: epsilon cycles, closures
+ * that change when the NFA does, and agreement between every way of
+ * running an NFA (each backend, and the DFA from nfa_to_dfa).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "IntSet.h"
+#include "nfa.h"
+#include "dfa.h"
+#include "nfatodfa.h"
+#include "test_util.h"
+
+static const NFA_BACKEND backends[] = {
+    NFA_BACKEND_SETS, NFA_BACKEND_LAZY_DFA, NFA_BACKEND_BIT_PARALLEL
+};
+static const char *backendNames[] = { "sets", "lazy DFA", "bit-parallel" };
+
+//checks that the epsilon-closure of the given state is exactly the states
+//listed in expected, like "0 1 2"
+static void check_closure(NFA* nfa, int state, const char *expected) {
+    const IntSet *closure = NFA_get_epsilon_closure(nfa, state);
+    char got[128] = "";
+    for (int s = 0; s < NFA_get_size(nfa); s++) {
+        if (IntSet_contains(closure, s)) {
+            size_t used = strlen(got);
+            snprintf(got + used, sizeof(got) - used, "%s%d", used > 0 ? " " : "", s);
+        }
+    }
+    printf("closure of %d = %s\n", state, got);
+    if (strcmp(got, expected) != 0) {
+        printf("  FAILED: expected %s\n", expected);
+        test_failures++;
+    }
+}
+
+//checks the given NFA on the given string with each backend and with the
+//DFA nfa_to_dfa builds from it
+static void check_run(NFA* nfa, const char *input, bool expected) {
+    size_t len = strlen(input);
+    for (int i = 0; i < 3; i++) {
+        NFA_set_backend(nfa, backends[i]);
+        char what[128];
+        snprintf(what, sizeof(what), "\"%s\" accepted (%s)", input, backendNames[i]);
+        check(what, NFA_run(nfa, (const unsigned char *)input, len), expected);
+    }
+    DFA *dfa = nfa_to_dfa(nfa);
+    char what[128];
+    snprintf(what, sizeof(what), "\"%s\" accepted (nfa_to_dfa)", input);
+    check(what, DFA_run(dfa, (const unsigned char *)input, len), expected);
+    DFA_free(dfa);
+}
+
+//returns the number of strings of up to maxLen symbols from alphabet on
+//which some way of running the NFA that build returns disagrees with
+//set-by-set simulation (one NFA per backend, since changing the backend
+//drops its tables)
+static int count_disagreements(NFA* (*build)(), const char *alphabet, int maxLen) {
+    NFA *nfas[3];
+    for (int i = 0; i < 3; i++) {
+        nfas[i] = build();
+        NFA_set_backend(nfas[i], backends[i]);
+    }
+    DFA *dfa = nfa_to_dfa(nfas[0]);
+    DFA *finalized = nfa_to_dfa(nfas[0]);
+    DFA_finalize(finalized);
+    int k = strlen(alphabet);
+    unsigned char input[32];
+    int digits[32];
+    int disagreements = 0;
+    for (int len = 0; len <= maxLen; len++) {
+        memset(digits, 0, sizeof(digits));
+        while (true) {
+            for (int i = 0; i < len; i++) {
+                input[i] = alphabet[digits[i]];
+            }
+            bool expected = NFA_run(nfas[0], input, len);
+            bool same = DFA_run(dfa, input, len) == expected
+                && DFA_run(finalized, input, len) == expected;
+            for (int i = 1; i < 3; i++) {
+                same = same && NFA_run(nfas[i], input, len) == expected;
+            }
+            if (!same) {
+                disagreements++;
+            }
+            //next string of this length, like counting in base k
+            int i = 0;
+            while (i < len && ++digits[i] == k) {
+                digits[i++] = 0;
+            }
+            if (i == len) {
+                break;
+            }
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        NFA_free(nfas[i]);
+    }
+    DFA_free(dfa);
+    DFA_free(finalized);
+    return disagreements;
+}
+
+//0 -> 1 -> 2 -> 0 on epsilon, 2 -a-> 3, and 3 <-> 4 on epsilon with 4
+//accepting and 3 -b-> 0
+static NFA* cycles_nfa() {
+    NFA *nfa = NFA_new(5);
+    NFA_add_epsilon_transition(nfa, 0, 1);
+    NFA_add_epsilon_transition(nfa, 1, 2);
+    NFA_add_epsilon_transition(nfa, 2, 0);
+    NFA_add_epsilon_transition(nfa, 1, 1);
+    NFA_add_transition(nfa, 2, 'a', 3);
+    NFA_add_epsilon_transition(nfa, 3, 4);
+    NFA_add_epsilon_transition(nfa, 4, 3);
+    NFA_add_transition(nfa, 3, 'b', 0);
+    NFA_set_accepting(nfa, 4, true);
+    return nfa;
+}
+
+//a chain of blocks i, i+1, i+2: i -> i+1 on epsilon, i+1 -a-> i+2, and
+//i+2 -b-> i+3 or back to i on epsilon, with a jump on b from the start
+//to the second word of states and back to the start on epsilon at the end
+static NFA* chain_nfa() {
+    int n = 91;
+    NFA *nfa = NFA_new(n);
+    for (int i = 0; i + 3 < n; i += 3) {
+        NFA_add_epsilon_transition(nfa, i, i + 1);
+        NFA_add_transition(nfa, i + 1, 'a', i + 2);
+        NFA_add_transition(nfa, i + 2, 'b', i + 3);
+        NFA_add_epsilon_transition(nfa, i + 2, i);
+    }
+    NFA_add_transition(nfa, 0, 'b', 63);
+    NFA_add_epsilon_transition(nfa, n - 1, 0);
+    NFA_set_accepting(nfa, 7, true);
+    NFA_set_accepting(nfa, 70, true);
+    NFA_set_accepting(nfa, n - 1, true);
+    return nfa;
+}
+
+int
+main(int argc, char **argv) {
+    printf("epsilon cycles\n");
+    NFA *nfa = cycles_nfa();
+    check("has epsilon transitions", NFA_has_epsilon_transitions(nfa), true);
+    check_closure(nfa, 0, "0 1 2");
+    check_closure(nfa, 1, "0 1 2");
+    check_closure(nfa, 3, "3 4");
+    check_run(nfa, "", false);
+    check_run(nfa, "a", true);
+    check_run(nfa, "ab", false);
+    check_run(nfa, "aba", true);
+    check_run(nfa, "aa", false);
+    NFA_free(nfa);
+    check("inputs where running disagrees", count_disagreements(cycles_nfa, "abc", 8), 0);
+
+    printf("changing the NFA after running it\n");
+    for (int i = 0; i < 3; i++) {
+        printf("%s\n", backendNames[i]);
+        nfa = NFA_new(4);
+        NFA_add_epsilon_transition(nfa, 0, 1);
+        NFA_add_transition(nfa, 1, 'a', 2);
+        NFA_set_accepting(nfa, 3, true);
+        NFA_set_backend(nfa, backends[i]);
+        check_closure(nfa, 0, "0 1");
+        check_closure(nfa, 2, "2");
+        check("a accepted", NFA_run(nfa, (const unsigned char *)"a", 1), false);
+        NFA_add_epsilon_transition(nfa, 2, 3);
+        check_closure(nfa, 2, "2 3");
+        check("a accepted", NFA_run(nfa, (const unsigned char *)"a", 1), true);
+        check("\"\" accepted", NFA_run(nfa, (const unsigned char *)"", 0), false);
+        NFA_add_epsilon_transition(nfa, 1, 3);
+        check_closure(nfa, 0, "0 1 3");
+        check("\"\" accepted", NFA_run(nfa, (const unsigned char *)"", 0), true);
+        NFA_add_transition(nfa, 3, 'b', 0);
+        check("abab accepted", NFA_run(nfa, (const unsigned char *)"abab", 4), true);
+        check("abb accepted", NFA_run(nfa, (const unsigned char *)"abb", 3), true);
+        check("abc accepted", NFA_run(nfa, (const unsigned char *)"abc", 3), false);
+        NFA_free(nfa);
+    }
+
+    printf("epsilon transitions among more than 64 states\n");
+    nfa = chain_nfa();
+    check("babab accepted", NFA_run(nfa, (const unsigned char *)"babab", 5), true);
+    check("bab accepted", NFA_run(nfa, (const unsigned char *)"bab", 3), false);
+    NFA_free(nfa);
+    check("inputs where running disagrees", count_disagreements(chain_nfa, "ab", 14), 0);
+
+    return test_summary();
+}
@@ -0,0 +1,291 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: nfabits.c
+ *
+ * Masks are arrays of nwords 64-bit words; bit s of a mask is state s.
+ * Every NFA gets succ[sym][s], the successors of state s on sym, and the
+ * general step ORs succ[sym][s] over the active states s.
+ * If the NFA is in Glushkov form, succ[sym][s] == follow[s] & symbol[sym],
+ * so a step is a lookup of follow[] for each byte of the active mask in
+ * a 256-entry table per byte position, ORed together and ANDed with
+ * symbol[sym]: for NFAs of up to 64 states that is 8 loads and an AND.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "nfabits.h"
+#include "IntSet.h"
+
+//follow tables cost (nstates/8)*256 masks; skip them for huge NFAs
+#define MAX_GLUSHKOV_STATES 512
+
+struct BitNFA {
+    int numOfStates;
+    int nwords;
+    uint64_t *succ;      //256 * numOfStates masks: successors on sym of s
+    uint64_t *start;     //one mask: the epsilon-closure of state 0
+    uint64_t *accepting; //one mask
+    uint64_t *absorbing; //one mask: accepting states that loop on every sym
+    bool isGlushkov;
+    uint64_t *symbol;    //256 masks: states entered on sym
+    uint64_t *follow;    //numOfChunks * 256 masks: follow sets of a byte
+    int numOfChunks;     //of the active mask, indexed [chunk][byte]
+};
+
+//returns a zeroed array of count masks (at least one word, since an NFA
+//with no states has masks of no words)
+static uint64_t* BitNFA_masks(const BitNFA* bits, int count) {
+    size_t words = (size_t)count * bits->nwords;
+    uint64_t *masks = (uint64_t*)calloc(words > 0 ? words : 1, sizeof(uint64_t));
+    if (masks == NULL) {
+        abort();
+    }
+    return masks;
+}
+
+//sets the bits of mask for the members of set
+static void BitNFA_set_mask(uint64_t *mask, const IntSet* set) {
+    IntSetIterator *iterator = IntSet_iterator(set);
+    while (IntSetIterator_has_next(iterator)) {
+        int s = IntSetIterator_next(iterator);
+        mask[s / 64] |= (uint64_t)1 << (s % 64);
+    }
+    free(iterator);
+}
+
+static uint64_t* BitNFA_succ(const BitNFA* bits, int sym, int state) {
+    return bits->succ + ((size_t)sym * bits->numOfStates + state) * bits->nwords;
+}
+
+//builds the per-byte follow tables if every succ[sym][s] is
+//follow[s] & symbol[sym]
+static void BitNFA_build_glushkov(BitNFA* bits) {
+    int n = bits->numOfStates;
+    int w = bits->nwords;
+    bits->isGlushkov = false;
+    if (n > MAX_GLUSHKOV_STATES) {
+        return;
+    }
+    uint64_t *stateFollow = BitNFA_masks(bits, n);
+    bits->symbol = BitNFA_masks(bits, NFA_NUM_SYMBOLS);
+    for (int sym = 0; sym < NFA_NUM_SYMBOLS; sym++) {
+        for (int s = 0; s < n; s++) {
+            uint64_t *succ = BitNFA_succ(bits, sym, s);
+            for (int i = 0; i < w; i++) {
+                bits->symbol[sym*w + i] |= succ[i];
+                stateFollow[s*w + i] |= succ[i];
+            }
+        }
+    }
+    for (int sym = 0; sym < NFA_NUM_SYMBOLS; sym++) {
+        for (int s = 0; s < n; s++) {
+            uint64_t *succ = BitNFA_succ(bits, sym, s);
+            for (int i = 0; i < w; i++) {
+                if (succ[i] != (stateFollow[s*w + i] & bits->symbol[sym*w + i])) {
+                    free(stateFollow);
+                    free(bits->symbol);
+                    bits->symbol = NULL;
+                    return;
+                }
+            }
+        }
+    }
+    bits->numOfChunks = (n + 7) / 8;
+    bits->follow = BitNFA_masks(bits, bits->numOfChunks * 256);
+    for (int chunk = 0; chunk < bits->numOfChunks; chunk++) {
+        for (int byte = 1; byte < 256; byte++) {
+            //table[byte] = table[byte without its lowest bit] | follow of that bit
+            int low = byte & -byte;
+            int s = chunk*8 + __builtin_ctz(low);
+            uint64_t *dst = bits->follow + ((size_t)chunk*256 + byte) * w;
+            uint64_t *rest = bits->follow + ((size_t)chunk*256 + (byte ^ low)) * w;
+            for (int i = 0; i < w; i++) {
+                dst[i] = rest[i] | (s < n ? stateFollow[s*w + i] : 0);
+            }
+        }
+    }
+    free(stateFollow);
+    bits->isGlushkov = true;
+}
+
+/**
+ * Precompute and return the successor masks for the given NFA.
+ */
+extern BitNFA* BitNFA_new(NFA* nfa) {
+    BitNFA *bits = (BitNFA*)malloc(sizeof(BitNFA));
+    if (bits == NULL) {
+        abort();
+    }
+    int n = NFA_get_size(nfa);
+    bits->numOfStates = n;
+    bits->nwords = (n + 63) / 64;
+    bits->succ = BitNFA_masks(bits, NFA_NUM_SYMBOLS * n);
+    bits->start = BitNFA_masks(bits, 1);
+    bits->accepting = BitNFA_masks(bits, 1);
+    bits->absorbing = BitNFA_masks(bits, 1);
+    bits->symbol = NULL;
+    bits->follow = NULL;
+    bits->numOfChunks = 0;
+    for (int s = 0; s < n; s++) {
+        if (NFA_get_accepting(nfa, s)) {
+            bits->accepting[s / 64] |= (uint64_t)1 << (s % 64);
+        }
+        for (int sym = 0; sym < NFA_NUM_SYMBOLS; sym++) {
+            uint64_t *succ = BitNFA_succ(bits, sym, s);
+            if (!NFA_has_epsilon_transitions(nfa)) {
+                BitNFA_set_mask(succ, NFA_get_transitions(nfa, s, sym));
+                continue;
+            }
+            //epsilon-closures are folded into the successor masks
+            IntSet *successors = IntSet_new_with_capacity(n);
+            IntSet_union(successors, NFA_get_transitions(nfa, s, sym));
+            NFA_close_set(nfa, successors);
+            BitNFA_set_mask(succ, successors);
+            IntSet_free(successors);
+        }
+    }
+    IntSet *start = NFA_start_set(nfa);
+    BitNFA_set_mask(bits->start, start);
+    IntSet_free(start);
+    BitNFA_set_mask(bits->absorbing, NFA_get_absorbing_states(nfa));
+    BitNFA_build_glushkov(bits);
+    return bits;
+}
+
+/**
+ * Free the given BitNFA.
+ */
+extern void BitNFA_free(BitNFA* bits) {
+    free(bits->succ);
+    free(bits->start);
+    free(bits->accepting);
+    free(bits->absorbing);
+    free(bits->symbol);
+    free(bits->follow);
+    free(bits);
+}
+
+extern bool BitNFA_is_glushkov(const BitNFA* bits) {
+    return bits->isGlushkov;
+}
+
+//single-word version of the Glushkov step for NFAs of up to 64 states
+static bool BitNFA_run_glushkov64(const BitNFA* bits, const unsigned char *input, size_t len) {
+    uint64_t active = bits->start[0];
+    for (size_t i = 0; i < len; i++) {
+        uint64_t next = 0;
+        for (int chunk = 0; chunk < bits->numOfChunks; chunk++) {
+            next |= bits->follow[chunk*256 + ((active >> (8*chunk)) & 0xff)];
+        }
+        active = next & bits->symbol[input[i]];
+        if (active == 0) {
+            return false;
+        }
+        if ((active & bits->absorbing[0]) != 0) {
+            return true;
+        }
+    }
+    return (active & bits->accepting[0]) != 0;
+}
+
+//advances the active mask over the len bytes at input, stopping once it
+//is empty or holds an absorbing state, and returns true if it then holds
+//an accepting state
+static bool BitNFA_run_mask(const BitNFA* bits, uint64_t *mask,
+                            const unsigned char *input, size_t len) {
+    int w = bits->nwords;
+    uint64_t *active = mask;
+    uint64_t *next = BitNFA_masks(bits, 1);
+    bool alive = true;
+    for (size_t i = 0; i < len && alive; i++) {
+        int sym = input[i];
+        memset(next, 0, w * sizeof(uint64_t));
+        if (bits->isGlushkov) {
+            for (int chunk = 0; chunk < bits->numOfChunks; chunk++) {
+                int byte = (active[chunk / 8] >> (8 * (chunk % 8))) & 0xff;
+                const uint64_t *follow = bits->follow + ((size_t)chunk*256 + byte) * w;
+                for (int j = 0; j < w; j++) {
+                    next[j] |= follow[j];
+                }
+            }
+            for (int j = 0; j < w; j++) {
+                next[j] &= bits->symbol[sym*w + j];
+            }
+        } else {
+            for (int j = 0; j < w; j++) {
+                uint64_t word = active[j];
+                while (word != 0) {
+                    int s = j*64 + __builtin_ctzll(word);
+                    const uint64_t *succ = BitNFA_succ(bits, sym, s);
+                    for (int k = 0; k < w; k++) {
+                        next[k] |= succ[k];
+                    }
+                    word &= word - 1;
+                }
+            }
+        }
+        uint64_t *tmp = active;
+        active = next;
+        next = tmp;
+        //an absorbing state keeps the NFA accepting, so stop there too
+        bool anyActive = false;
+        bool absorbed = false;
+        for (int j = 0; j < w; j++) {
+            anyActive = anyActive || active[j] != 0;
+            absorbed = absorbed || (active[j] & bits->absorbing[j]) != 0;
+        }
+        alive = anyActive && !absorbed;
+    }
+    bool accepting = false;
+    for (int j = 0; j < w; j++) {
+        accepting = accepting || (active[j] & bits->accepting[j]) != 0;
+    }
+    //the states reached may be in the scratch mask after an odd number of steps
+    if (active != mask) {
+        memcpy(mask, active, w * sizeof(uint64_t));
+        next = active;
+    }
+    free(next);
+    return accepting;
+}
+
+/**
+ * Run the NFA on the len bytes at input, and return true if it accepts
+ * them, otherwise false.
+ */
+extern bool BitNFA_run(const BitNFA* bits, const unsigned char *input, size_t len) {
+    if (bits->isGlushkov && bits->nwords == 1) {
+        return BitNFA_run_glushkov64(bits, input, len);
+    }
+    uint64_t *active = BitNFA_masks(bits, 1);
+    memcpy(active, bits->start, bits->nwords * sizeof(uint64_t));
+    bool accepting = BitNFA_run_mask(bits, active, input, len);
+    free(active);
+    return accepting;
+}
+
+/**
+ * Run the NFA on the len bytes at input starting from the given set of
+ * NFA states, and replace the contents of that set with the states reached.
+ */
+extern bool BitNFA_run_from(const BitNFA* bits, IntSet* states,
+                            const unsigned char *input, size_t len) {
+    uint64_t *active = BitNFA_masks(bits, 1);
+    BitNFA_set_mask(active, states);
+    bool accepting = BitNFA_run_mask(bits, active, input, len);
+    IntSet_clear(states);
+    for (int j = 0; j < bits->nwords; j++) {
+        for (uint64_t word = active[j]; word != 0; word &= word - 1) {
+            IntSet_add(states, j*64 + __builtin_ctzll(word));
+        }
+    }
+    free(active);
+    return accepting;
+}
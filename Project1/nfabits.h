@@ -0,0 +1,61 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: nfabits.h
+ *
+ * Bit-parallel NFA simulation: the set of active states is kept as a
+ * bitmask (one 64-bit word per 64 states) and advanced with word
+ * operations on masks precomputed from the NFA's transitions.
+ */
+
+#ifndef _nfabits_h
+#define _nfabits_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "nfa.h"
+#include "IntSet.h"
+
+// Partial declaration
+typedef struct BitNFA BitNFA;
+
+/**
+ * Precompute and return the successor masks for the given NFA.
+ * The BitNFA is a snapshot: later changes to the NFA are not seen.
+ */
+extern BitNFA* BitNFA_new(NFA* nfa);
+
+/**
+ * Free the given BitNFA.
+ */
+extern void BitNFA_free(BitNFA* bits);
+
+/**
+ * Return true if the NFA is in Glushkov form (every transition into a
+ * state is on the same symbols, so the successors of the active set are
+ * Follow(active) & Symbol[sym]) and can be advanced with table lookups
+ * instead of one mask per active state.
+ */
+extern bool BitNFA_is_glushkov(const BitNFA* bits);
+
+/**
+ * Run the NFA on the len bytes at input, and return true if it accepts
+ * them, otherwise false.
+ */
+extern bool BitNFA_run(const BitNFA* bits, const unsigned char *input, size_t len);
+
+/**
+ * Run the NFA on the len bytes at input starting from the given set of
+ * NFA states instead of the start set, and replace the contents of that
+ * set with the states reached (empty once no state is left). Returns true
+ * if that set contains an accepting state. This lets a run be split
+ * across several pieces of input.
+ */
+extern bool BitNFA_run_from(const BitNFA* bits, IntSet* states,
+                            const unsigned char *input, size_t len);
+
+#endif
@@ -9,34 +9,156 @@
 #include <stdlib.h>
 #include "nfatodfa.h"
 #include "IntSet.h"
-#include "LinkedList.h"
+#include "IntSetTable.h"
 #include "nfa.h"
 #include "dfa.h"
+#include "dfamin.h"
 #include <string.h>
 
-extern DFA_STATES* new_DFA_STATE() {
-  DFA_STATES* dfa_state = (DFA_STATES*)malloc(sizeof(DFA_STATES));
-  dfa_state->isAccepting = false;
-  for (int i = 0; i < 128; i++) {
-    dfa_state->transition[i] = -1;
-  }
-  return dfa_state;
+/**
+ * Build and return a new DFA accepting the same language as the given NFA
+ * using the subset construction.
+ */
+extern DFA* nfa_to_dfa(NFA* nfa) {
+    return nfa_to_dfa_with_sets(nfa, NULL);
 }
 
-extern DFA* nfa_to_dfa(NFA* nfa) {
-  IntSet statesSet = IntSet_new();
+/**
+ * Build the DFA for the given NFA, optionally handing back the table of
+ * the NFA state sets its states were built from.
+ */
+extern DFA* nfa_to_dfa_with_sets(NFA* nfa, IntSetTable **sets) {
+    int nstates = NFA_get_size(nfa);
+    IntSetTable *table = IntSetTable_new();
 
+    IntSetTable_intern(table, NFA_start_set(nfa));
 
-  //Creates a set of all the states in the new DFA
-  for(int i = 0; i < nfa->numOfStates; i++){
-    for(int j = 0 j < 128; j++){
-      if(IntSet_contains(statesSet, nfa->NFA_STATES[i]->transition[j] != true)){
-        IntSet_add(statesSet, nfa->NFA_STATES[i]->transition[j]);
-      }
+    //states are numbered in discovery order, so the sets numbered from
+    //current up to the size of the table are the unprocessed worklist
+    int (*transitions)[NFA_NUM_SYMBOLS] = NULL;
+    int rows = 0;
+    int *members = (int *)malloc(nstates*sizeof(int));
+    for (int current = 0; current < IntSetTable_size(table); current++) {
+        if (current == rows) {
+            rows = rows == 0 ? 16 : 2*rows;
+            transitions = realloc(transitions, rows*sizeof(*transitions));
+            if (transitions == NULL) {
+                abort();
+            }
+        }
+        int numOfMembers = 0;
+        IntSetIterator *iterator = IntSet_iterator(IntSetTable_get(table, current));
+        while (IntSetIterator_has_next(iterator)) {
+            members[numOfMembers++] = IntSetIterator_next(iterator);
+        }
+        free(iterator);
+
+        for (int sym = 0; sym < NFA_NUM_SYMBOLS; sym++) {
+            IntSet *next = IntSet_new_with_capacity(nstates);
+            for (int i = 0; i < numOfMembers; i++) {
+                IntSet_union(next, NFA_get_transitions(nfa, members[i], sym));
+            }
+            NFA_close_set(nfa, next);
+            if (IntSet_is_empty(next)) {
+                IntSet_free(next);
+                transitions[current][sym] = -1;
+            } else {
+                transitions[current][sym] = IntSetTable_intern(table, next);
+            }
+        }
     }
-  }
+    free(members);
 
-  DFA *dfa = (DFA*)malloc(sizeof(DFA));
+    DFA *dfa = DFA_new(IntSetTable_size(table));
+    for (int state = 0; state < IntSetTable_size(table); state++) {
+        for (int sym = 0; sym < NFA_NUM_SYMBOLS; sym++) {
+            DFA_set_transition(dfa, state, sym, transitions[state][sym]);
+        }
+        IntSetIterator *iterator = IntSet_iterator(IntSetTable_get(table, state));
+        while (IntSetIterator_has_next(iterator)) {
+            if (NFA_get_accepting(nfa, IntSetIterator_next(iterator))) {
+                DFA_set_accepting(dfa, state, true);
+                break;
+            }
+        }
+        free(iterator);
+    }
+    free(transitions);
+    if (sets != NULL) {
+        *sets = table;
+    } else {
+        IntSetTable_free(table);
+    }
+    return dfa;
+}
 
+/**
+ * Build and return a new NFA accepting the reverse of each input the
+ * given NFA accepts.
+ */
+extern NFA* NFA_reverse(NFA* nfa) {
+    int nstates = NFA_get_size(nfa);
+    //state 0 is a new start state that moves to each accepting state
+    //without reading anything, and state s of the given NFA becomes s + 1
+    NFA *reverse = NFA_new(nstates + 1);
+    bool hasEpsilon = NFA_has_epsilon_transitions(nfa);
+    for (int src = 0; src < nstates; src++) {
+        for (int sym = 0; sym < NFA_NUM_SYMBOLS; sym++) {
+            IntSetIterator *iterator = IntSet_iterator(NFA_get_transitions(nfa, src, sym));
+            while (IntSetIterator_has_next(iterator)) {
+                NFA_add_transition(reverse, IntSetIterator_next(iterator) + 1, sym, src + 1);
+            }
+            free(iterator);
+        }
+        if (hasEpsilon) {
+            //closures are already transitive, so reversing them is enough
+            IntSetIterator *iterator = IntSet_iterator(NFA_get_epsilon_closure(nfa, src));
+            while (IntSetIterator_has_next(iterator)) {
+                int dst = IntSetIterator_next(iterator);
+                if (dst != src) {
+                    NFA_add_epsilon_transition(reverse, dst + 1, src + 1);
+                }
+            }
+            free(iterator);
+        }
+        if (NFA_get_accepting(nfa, src)) {
+            NFA_add_epsilon_transition(reverse, 0, src + 1);
+        }
+    }
+    if (nstates > 0) {
+        NFA_set_accepting(reverse, 1, true);
+    }
+    return reverse;
+}
 
+/**
+ * Build and return a new DFA accepting the reverse of each input the
+ * given DFA accepts.
+ */
+extern DFA* DFA_reverse(DFA* dfa) {
+    int nstates = DFA_get_size(dfa);
+    //the DFA's transitions turned around, with the same extra start state
+    //as in NFA_reverse
+    NFA *reverse = NFA_new(nstates + 1);
+    for (int src = 0; src < nstates; src++) {
+        for (int sym = 0; sym < NFA_NUM_SYMBOLS; sym++) {
+            int dst = DFA_get_transition(dfa, src, sym);
+            if (dst >= 0) {
+                NFA_add_transition(reverse, dst + 1, sym, src + 1);
+            }
+        }
+        if (DFA_get_accepting(dfa, src)) {
+            NFA_add_epsilon_transition(reverse, 0, src + 1);
+        }
+    }
+    if (nstates > 0) {
+        NFA_set_accepting(reverse, 1, true);
+    }
+    //the extra start state keeps the start set apart from later sets of
+    //the same states, so the subsets need minimizing
+    DFA *subsets = nfa_to_dfa(reverse);
+    NFA_free(reverse);
+    DFA *result = DFA_minimize(subsets, NULL);
+    DFA_free(subsets);
+    return result;
 }
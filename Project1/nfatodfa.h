@@ -4,13 +4,47 @@
  * Net ID: skaveti, rracico3, bneupane
  */
 
-#include <stdio.h>
-#include <stdbool.h>
-#include <stdlib.h>
-#include <string.h>
-#include "IntSet.h"
-#include "LinkedList.h"
+#ifndef _nfatodfa_h
+#define _nfatodfa_h
 
+#include "nfa.h"
+#include "dfa.h"
+#include "IntSetTable.h"
+
+/**
+ * Build and return a new DFA accepting the same language as the given NFA
+ * using the subset construction (FOCS Section 10.4).
+ * DFA state 0 corresponds to the NFA start set (the epsilon-closure of
+ * state 0), and only reachable sets of NFA states, each closed under
+ * epsilon transitions, become DFA states. The empty set is not
+ * materialized: transitions into it are left at -1, like any missing DFA
+ * transition.
+ */
 extern DFA* nfa_to_dfa(NFA* nfa);
 
-extern STATES* new_DFA_STATE();
+/**
+ * Like nfa_to_dfa, but if sets is not NULL also set *sets to a new table
+ * in which set number i is the set of NFA states that DFA state i stands
+ * for. Don't forget to IntSetTable_free() it.
+ */
+extern DFA* nfa_to_dfa_with_sets(NFA* nfa, IntSetTable **sets);
+
+/**
+ * Build and return a new NFA accepting exactly the reverses of the inputs
+ * the given NFA accepts ("nam" for "man"), with every transition turned
+ * around: a new start state 0 moves to each accepting state on epsilon,
+ * state s of the given NFA becomes state s + 1, and the old start state
+ * is the only accepting one. Patterns that only look at the end of the
+ * input, like problem 2a, look only at the start once reversed.
+ */
+extern NFA* NFA_reverse(NFA* nfa);
+
+/**
+ * Build and return a new minimal DFA accepting exactly the reverses of
+ * the inputs the given DFA accepts, by the subset construction on its
+ * reversed transitions followed by DFA_minimize. Run it with
+ * DFA_run_backwards to test the original inputs from right to left.
+ */
+extern DFA* DFA_reverse(DFA* dfa);
+
+#endif
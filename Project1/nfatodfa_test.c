@@ -0,0 +1,126 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: nfatodfa_test.c
+ *
+ * Test program for the subset construction: the DFAs it builds for the
+ * automata of problem 2 against running the NFAs, and the set of NFA
+ * states each DFA state stands for against the sets the NFAs reach.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "IntSet.h"
+#include "IntSetTable.h"
+#include "nfa.h"
+#include "dfa.h"
+#include "nfatodfa.h"
+#include "test_util.h"
+
+#define NUM_INPUTS 2000
+#define MAX_LEN 24
+
+//returns the set of NFA states reached on the len bytes at input, one
+//byte at a time from the start set (empty once no state is left)
+static IntSet* reached_set(NFA* nfa, const unsigned char *input, size_t len) {
+    IntSet *set = NFA_start_set(nfa);
+    for (size_t i = 0; i < len; i++) {
+        IntSet *next = IntSet_new_with_capacity(NFA_get_size(nfa));
+        IntSetIterator *iterator = IntSet_iterator(set);
+        while (IntSetIterator_has_next(iterator)) {
+            int s = IntSetIterator_next(iterator);
+            IntSet_union(next, NFA_get_transitions(nfa, s, input[i]));
+        }
+        free(iterator);
+        NFA_close_set(nfa, next);
+        IntSet_free(set);
+        set = next;
+    }
+    return set;
+}
+
+//returns the DFA state reached on the len bytes at input, or -1 once a
+//transition is missing
+static int reached_state(DFA* dfa, const unsigned char *input, size_t len) {
+    int state = 0;
+    for (size_t i = 0; i < len && state >= 0; i++) {
+        state = DFA_get_transition(dfa, state, input[i]);
+    }
+    return state;
+}
+
+//builds the DFA for the NFA that build returns and checks it on random
+//inputs over alphabet: the set of each state reached against the NFA's,
+//and acceptance against NFA_run before and after finalizing
+static void check_subsets(const char *name, NFA* (*build)(), const char *alphabet,
+                          int expectedStates) {
+    NFA *nfa = build();
+    NFA_set_backend(nfa, NFA_BACKEND_SETS);
+    IntSetTable *sets = NULL;
+    DFA *dfa = nfa_to_dfa_with_sets(nfa, &sets);
+    printf("DFA for %s\n", name);
+    check("states", DFA_get_size(dfa), expectedStates);
+    check("sets", IntSetTable_size(sets), DFA_get_size(dfa));
+    IntSet *start = NFA_start_set(nfa);
+    check("state 0 is the start set", IntSet_equals(IntSetTable_get(sets, 0), start), true);
+    IntSet_free(start);
+
+    //a set is interned only once, so no two states stand for the same set
+    int repeated = 0;
+    for (int s = 0; s < IntSetTable_size(sets); s++) {
+        if (IntSetTable_lookup(sets, IntSetTable_get(sets, s)) != s) {
+            repeated++;
+        }
+    }
+    check("states with a repeated set", repeated, 0);
+
+    //the same inputs before and after finalizing
+    int k = strlen(alphabet);
+    int wrongSets = 0;
+    int wrongRuns[2] = { 0, 0 };
+    unsigned char input[MAX_LEN];
+    for (int finalized = 0; finalized < 2; finalized++) {
+        srand(1);
+        for (int n = 0; n < NUM_INPUTS; n++) {
+            size_t len = rand() % (MAX_LEN + 1);
+            for (size_t i = 0; i < len; i++) {
+                input[i] = alphabet[rand() % k];
+            }
+            if (DFA_run(dfa, input, len) != NFA_run(nfa, input, len)) {
+                wrongRuns[finalized]++;
+            }
+            if (finalized) {
+                continue;
+            }
+            IntSet *set = reached_set(nfa, input, len);
+            int state = reached_state(dfa, input, len);
+            if (state < 0 ? !IntSet_is_empty(set)
+                : !IntSet_equals(IntSetTable_get(sets, state), set)) {
+                wrongSets++;
+            }
+            IntSet_free(set);
+        }
+        DFA_finalize(dfa);
+    }
+    check("states whose set is not the NFA's", wrongSets, 0);
+    check("runs that disagree with the NFA", wrongRuns[0], 0);
+    check("runs that disagree with the NFA after finalizing", wrongRuns[1], 0);
+
+    IntSetTable_free(sets);
+    DFA_free(dfa);
+    NFA_free(nfa);
+}
+
+int
+main(int argc, char **argv) {
+    check_subsets("problem 2a", problem_2_a_nfa, "manxmmaan", 4);
+    check_subsets("problem 2b", problem_2_b_nfa, "aghinostwnxyz", 26244);
+    check_subsets("problem 2c", problem_2_c_nfa, "codexccoodde", 8);
+    return test_summary();
+}
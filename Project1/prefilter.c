@@ -0,0 +1,314 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: prefilter.c
+ *
+ * The analysis runs on the minimal DFA, with the accepting states merged
+ * into one sink and the transitions out of them dropped, since only the
+ * way to the first accepting state matters. Dominators of the sink are
+ * found with the iterative algorithm of Cooper, Harvey and Kennedy over
+ * the reachable states in reverse postorder; following them up from the
+ * sink gives the chain of states every accepting run visits in order.
+ */
+
+#define _GNU_SOURCE   //for memmem
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "dfa.h"
+#include "nfa.h"
+#include "dfamin.h"
+#include "nfatodfa.h"
+#include "prefilter.h"
+
+//values of the pred and inByte arrays besides states and bytes
+#define PREFILTER_NONE -1
+#define PREFILTER_MANY -2
+
+struct Prefilter {
+    const DFA *dfa;
+    unsigned char *literal;
+    size_t len;
+};
+
+static void *prefilter_alloc(size_t count, size_t size) {
+    void *ptr = malloc((count > 0 ? count : 1) * size);
+    if (ptr == NULL) {
+        abort();
+    }
+    return ptr;
+}
+
+//records that value was seen where *slot keeps the only value seen so far
+static void prefilter_note(int *slot, int value) {
+    if (*slot == PREFILTER_NONE) {
+        *slot = value;
+    } else if (*slot != value) {
+        *slot = PREFILTER_MANY;
+    }
+}
+
+//returns the closest common dominator of a and b, given the immediate
+//dominators found so far and each node's position in reverse postorder
+static int prefilter_intersect(const int *idom, const int *rpo, int a, int b) {
+    while (a != b) {
+        while (rpo[a] > rpo[b]) {
+            a = idom[a];
+        }
+        while (rpo[b] > rpo[a]) {
+            b = idom[b];
+        }
+    }
+    return a;
+}
+
+//finds the required literal of a minimal DFA
+static size_t prefilter_analyze(DFA* dfa, unsigned char **literal) {
+    int n = DFA_get_size(dfa);
+    if (n == 0 || DFA_get_accepting(dfa, 0)) {
+        return 0;
+    }
+    int sink = n;   //stands for every accepting state
+
+    //depth-first from the start, recording the distinct edges, the
+    //postorder, and for each node the only predecessor and the only byte
+    //it is entered on (if there is just one)
+    int *pred = (int *)prefilter_alloc(n + 1, sizeof(int));
+    int *inByte = (int *)prefilter_alloc(n + 1, sizeof(int));
+    bool *visited = (bool *)prefilter_alloc(n + 1, sizeof(bool));
+    int *lastSource = (int *)prefilter_alloc(n + 1, sizeof(int));
+    int *postorder = (int *)prefilter_alloc(n + 1, sizeof(int));
+    int *stack = (int *)prefilter_alloc(n + 1, sizeof(int));
+    int *stackByte = (int *)prefilter_alloc(n + 1, sizeof(int));
+    for (int v = 0; v <= n; v++) {
+        pred[v] = PREFILTER_NONE;
+        inByte[v] = PREFILTER_NONE;
+        visited[v] = false;
+        lastSource[v] = PREFILTER_NONE;
+    }
+    size_t numOfEdges = 0;
+    size_t edgeCapacity = 64;
+    int (*edges)[2] = prefilter_alloc(edgeCapacity, sizeof(*edges));
+    int numOfPost = 0;
+    int depth = 0;
+    stack[depth] = 0;
+    stackByte[depth++] = 0;
+    visited[0] = true;
+    while (depth > 0) {
+        int s = stack[depth - 1];
+        int b = stackByte[depth - 1];
+        int next = -1;
+        for (; b < DFA_NUM_SYMBOLS && next < 0; b++) {
+            int t = s == sink ? -1 : DFA_get_transition(dfa, s, b);
+            if (t < 0) {
+                continue;
+            }
+            int v = DFA_get_accepting(dfa, t) ? sink : t;
+            prefilter_note(&pred[v], s);
+            prefilter_note(&inByte[v], b);
+            if (lastSource[v] != s) {
+                lastSource[v] = s;
+                if (numOfEdges == edgeCapacity) {
+                    edgeCapacity *= 2;
+                    edges = realloc(edges, edgeCapacity*sizeof(*edges));
+                    if (edges == NULL) {
+                        abort();
+                    }
+                }
+                edges[numOfEdges][0] = s;
+                edges[numOfEdges++][1] = v;
+            }
+            if (!visited[v]) {
+                visited[v] = true;
+                next = v;
+            }
+        }
+        stackByte[depth - 1] = b;
+        if (next >= 0) {
+            stack[depth] = next;
+            stackByte[depth++] = 0;
+        } else {
+            postorder[numOfPost++] = s;
+            depth--;
+        }
+    }
+
+    size_t len = 0;
+    if (visited[sink]) {
+        //predecessor lists, and positions in reverse postorder
+        int *first = (int *)calloc(n + 2, sizeof(int));
+        int *preds = (int *)prefilter_alloc(numOfEdges, sizeof(int));
+        int *rpo = (int *)prefilter_alloc(n + 1, sizeof(int));
+        int *idom = (int *)prefilter_alloc(n + 1, sizeof(int));
+        if (first == NULL) {
+            abort();
+        }
+        for (size_t e = 0; e < numOfEdges; e++) {
+            first[edges[e][1] + 1]++;
+        }
+        for (int v = 0; v <= n; v++) {
+            first[v + 1] += first[v];
+        }
+        int *fill = lastSource;   //no longer needed
+        memcpy(fill, first, (n + 1)*sizeof(int));
+        for (size_t e = 0; e < numOfEdges; e++) {
+            preds[fill[edges[e][1]]++] = edges[e][0];
+        }
+        for (int i = 0; i < numOfPost; i++) {
+            rpo[postorder[i]] = numOfPost - 1 - i;
+            idom[postorder[i]] = PREFILTER_NONE;
+        }
+        idom[0] = 0;
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (int i = numOfPost - 1; i >= 0; i--) {
+                int v = postorder[i];
+                if (v == 0) {
+                    continue;
+                }
+                int dom = PREFILTER_NONE;
+                for (int j = first[v]; j < first[v + 1]; j++) {
+                    int p = preds[j];
+                    if (idom[p] == PREFILTER_NONE) {
+                        continue;
+                    }
+                    dom = dom == PREFILTER_NONE ? p : prefilter_intersect(idom, rpo, p, dom);
+                }
+                if (dom != idom[v]) {
+                    idom[v] = dom;
+                    changed = true;
+                }
+            }
+        }
+
+        //the dominator chain from the start to the sink, in order
+        int numOfChain = 0;
+        int *chain = stack;
+        for (int v = sink; ; v = idom[v]) {
+            chain[numOfChain++] = v;
+            if (v == 0) {
+                break;
+            }
+        }
+        for (int i = 0; i < numOfChain/2; i++) {
+            int tmp = chain[i];
+            chain[i] = chain[numOfChain - 1 - i];
+            chain[numOfChain - 1 - i] = tmp;
+        }
+
+        //the longest run of chain nodes each entered on one byte, all but
+        //the first only from the node before
+        int bestStart = 0;
+        int runStart = 0;
+        int runLen = 0;
+        for (int i = 0; i < numOfChain; i++) {
+            int v = chain[i];
+            if (runLen > 0 && pred[v] == chain[i - 1] && inByte[v] >= 0) {
+                runLen++;
+            } else if (v != 0 && inByte[v] >= 0) {
+                runStart = i;
+                runLen = 1;
+            } else {
+                runLen = 0;
+            }
+            if ((size_t)runLen > len) {
+                len = runLen;
+                bestStart = runStart;
+            }
+        }
+        if (len > 0) {
+            *literal = (unsigned char *)prefilter_alloc(len, 1);
+            for (size_t i = 0; i < len; i++) {
+                (*literal)[i] = (unsigned char)inByte[chain[bestStart + i]];
+            }
+        }
+        free(first);
+        free(preds);
+        free(rpo);
+        free(idom);
+    }
+    free(pred);
+    free(inByte);
+    free(visited);
+    free(lastSource);
+    free(postorder);
+    free(stack);
+    free(stackByte);
+    free(edges);
+    return len;
+}
+
+/**
+ * Find a literal that every input accepted by the given DFA contains.
+ */
+extern size_t DFA_required_literal(DFA* dfa, unsigned char **literal) {
+    *literal = NULL;
+    DFA *min = DFA_minimize(dfa, NULL);
+    size_t len = prefilter_analyze(min, literal);
+    DFA_free(min);
+    return len;
+}
+
+/**
+ * Find a literal that every input accepted by the given NFA contains.
+ */
+extern size_t NFA_required_literal(NFA* nfa, unsigned char **literal) {
+    DFA *dfa = nfa_to_dfa(nfa);
+    size_t len = DFA_required_literal(dfa, literal);
+    DFA_free(dfa);
+    return len;
+}
+
+/**
+ * Allocate and return a new Prefilter for the given DFA.
+ */
+extern Prefilter* Prefilter_new(DFA* dfa) {
+    Prefilter *prefilter = (Prefilter *)prefilter_alloc(1, sizeof(Prefilter));
+    prefilter->len = DFA_required_literal(dfa, &prefilter->literal);
+    DFA_finalize(dfa);
+    prefilter->dfa = dfa;
+    return prefilter;
+}
+
+/**
+ * Free the given Prefilter.
+ */
+extern void Prefilter_free(Prefilter* prefilter) {
+    free(prefilter->literal);
+    free(prefilter);
+}
+
+/**
+ * Set *literal to the required literal and return its length.
+ */
+extern size_t Prefilter_get_literal(const Prefilter* prefilter, const unsigned char **literal) {
+    *literal = prefilter->literal;
+    return prefilter->len;
+}
+
+/**
+ * Return the first occurrence of the required literal in [start, end).
+ */
+extern const unsigned char* Prefilter_find(const Prefilter* prefilter, const unsigned char *start,
+                                           const unsigned char *end) {
+    if (prefilter->len == 0) {
+        return start;
+    }
+    return (const unsigned char *)memmem(start, end - start, prefilter->literal, prefilter->len);
+}
+
+/**
+ * Run the DFA on the given input if it contains the required literal.
+ */
+extern bool Prefilter_run(const Prefilter* prefilter, const unsigned char *input, size_t len) {
+    if (Prefilter_find(prefilter, input, input + len) == NULL) {
+        return false;
+    }
+    return DFA_run(prefilter->dfa, input, len);
+}
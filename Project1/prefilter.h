@@ -0,0 +1,75 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: prefilter.h
+ *
+ * Finding a literal that every input an automaton accepts must contain,
+ * like "code" for problem 2c, and using it to reject inputs with a fast
+ * substring search before running the automaton at all.
+ *
+ * The literal comes from the dominators of acceptance: the states every
+ * run has to pass through on its way to its first accepting state. Where
+ * consecutive dominators can only be entered from the one before them,
+ * each on a single byte, those bytes are always read in a row.
+ */
+
+#ifndef _prefilter_h
+#define _prefilter_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "dfa.h"
+#include "nfa.h"
+
+/**
+ * Find the longest literal that the analysis shows every input accepted
+ * by the given DFA contains, set *literal to a malloc'ed copy of it (or
+ * NULL if there is none) and return its length (0 if there is none).
+ * Don't forget to free() it.
+ */
+extern size_t DFA_required_literal(DFA* dfa, unsigned char **literal);
+
+/**
+ * Like DFA_required_literal, for the minimal DFA of the given NFA.
+ */
+extern size_t NFA_required_literal(NFA* nfa, unsigned char **literal);
+
+// Partial declaration
+typedef struct Prefilter Prefilter;
+
+/**
+ * Allocate and return a new Prefilter for the given DFA, finding its
+ * required literal and finalizing it. The DFA is not copied, so it must
+ * not be changed or freed while the Prefilter is in use.
+ */
+extern Prefilter* Prefilter_new(DFA* dfa);
+
+/**
+ * Free the given Prefilter (but not its DFA).
+ */
+extern void Prefilter_free(Prefilter* prefilter);
+
+/**
+ * Set *literal to the given Prefilter's required literal and return its
+ * length, which is 0 if the DFA has none and every input is a candidate.
+ */
+extern size_t Prefilter_get_literal(const Prefilter* prefilter, const unsigned char **literal);
+
+/**
+ * Return the first occurrence of the required literal in [start, end),
+ * or NULL if there is none. Without a literal, returns start.
+ */
+extern const unsigned char* Prefilter_find(const Prefilter* prefilter, const unsigned char *start,
+                                           const unsigned char *end);
+
+/**
+ * Return true if the DFA accepts the len bytes at input, like DFA_run,
+ * but only run it if they contain the required literal.
+ */
+extern bool Prefilter_run(const Prefilter* prefilter, const unsigned char *input, size_t len);
+
+#endif
@@ -0,0 +1,90 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: prefilter_test.c
+ *
+ * Test program for finding the literal every accepted input contains, for
+ * the automata of problem 2 and some regular expressions, and for
+ * prefiltering runs with it.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "nfa.h"
+#include "dfa.h"
+#include "nfatodfa.h"
+#include "regexnfa.h"
+#include "prefilter.h"
+#include "test_util.h"
+
+//checks the required literal of the given NFA (freeing it), where
+//expected is NULL if there should be none
+static void check_literal(const char *name, NFA* nfa, const char *expected) {
+    unsigned char *literal = NULL;
+    size_t len = NFA_required_literal(nfa, &literal);
+    if (len > 0) {
+        printf("required literal of %s = \"%.*s\"\n", name, (int)len, (const char *)literal);
+    } else {
+        printf("required literal of %s = none\n", name);
+    }
+    bool same = expected == NULL ? len == 0 && literal == NULL
+        : len == strlen(expected) && memcmp(literal, expected, len) == 0;
+    if (!same) {
+        printf("  FAILED: expected %s\n", expected != NULL ? expected : "none");
+        test_failures++;
+    }
+    free(literal);
+    NFA_free(nfa);
+}
+
+int
+main(int argc, char **argv) {
+    printf("required literals\n");
+    check_literal("problem 2a", problem_2_a_nfa(), "man");
+    check_literal("problem 2b", problem_2_b_nfa(), NULL);
+    check_literal("problem 2c", problem_2_c_nfa(), "code");
+    check_literal("ab(c|d)", regex_to_nfa("ab(c|d)", NULL), "ab");
+    check_literal("(a|b)cd", regex_to_nfa("(a|b)cd", NULL), "cd");
+    check_literal("a|b", regex_to_nfa("a|b", NULL), NULL);
+    check_literal("x*", regex_to_nfa("x*", NULL), NULL);
+
+    printf("prefiltering problem 2c\n");
+    NFA *nfa = problem_2_c_nfa();
+    DFA *dfa = nfa_to_dfa(nfa);
+    NFA_free(nfa);
+    Prefilter *prefilter = Prefilter_new(dfa);
+    const unsigned char *literal;
+    size_t len = Prefilter_get_literal(prefilter, &literal);
+    check("literal is code", len == 4 && memcmp(literal, "code", 4) == 0, true);
+    const unsigned char *input = (const unsigned char *)"decoded codec";
+    size_t inputLen = strlen((const char *)input);
+    check("code found at 2", Prefilter_find(prefilter, input, input + inputLen) == input + 2, true);
+    check("code found at 8 from 3",
+          Prefilter_find(prefilter, input + 3, input + inputLen) == input + 8, true);
+    check("code found before 5", Prefilter_find(prefilter, input, input + 5) != NULL, false);
+    check("runs on decoded codec", Prefilter_run(prefilter, input, inputLen), true);
+    check("runs on cod e", Prefilter_run(prefilter, (const unsigned char *)"cod e", 5), false);
+    check("runs on \"\"", Prefilter_run(prefilter, input, 0), false);
+    Prefilter_free(prefilter);
+    DFA_free(dfa);
+
+    printf("prefiltering without a literal\n");
+    dfa = problem_1_c_dfa();
+    prefilter = Prefilter_new(dfa);
+    check("has a literal", Prefilter_get_literal(prefilter, &literal) > 0, false);
+    input = (const unsigned char *)"0110";
+    check("finds the start", Prefilter_find(prefilter, input, input + 4) == input, true);
+    check("runs on 0110", Prefilter_run(prefilter, input, 4), true);
+    check("runs on 011", Prefilter_run(prefilter, input, 3), true);
+    check("runs on 01", Prefilter_run(prefilter, input, 2), false);
+    Prefilter_free(prefilter);
+    DFA_free(dfa);
+
+    return test_summary();
+}
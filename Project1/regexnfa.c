@@ -0,0 +1,495 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "IntSet.h"
+#include "nfa.h"
+#include "regexnfa.h"
+
+//deepest nesting of groups accepted, so that a hostile pattern cannot
+//exhaust the stack
+#define REGEX_MAX_DEPTH 1000
+
+#define REGEX_ANCHOR_ERROR "^ and $ are only allowed at the start and end of a top-level alternative"
+
+typedef struct { //a set of bytes, bit b of bits[b/64] for byte b
+    uint64_t bits[4];
+} RegexClass;
+
+typedef struct { //what the Glushkov construction needs of a subexpression:
+                 //the positions that can start and end a match of it, and
+                 //whether it matches the empty string
+    IntSet *first;
+    IntSet *last;
+    bool nullable;
+} RegexPart;
+
+typedef struct { //the pattern being parsed and the positions found so far;
+                 //position p is NFA state p + 1, state 0 being the start
+    const char *pattern;
+    size_t pos;
+    const char *error;
+    int depth;
+    int numOfPositions;
+    int capacity;
+    RegexClass *classes;   //bytes each position matches
+    IntSet **follow;       //positions that can come right after each one
+} RegexParser;
+
+static RegexPart regex_parse_alternation(RegexParser *parser);
+
+//returns a part matching only the empty string
+static RegexPart regex_empty() {
+    RegexPart part;
+    part.first = IntSet_new();
+    part.last = IntSet_new();
+    part.nullable = true;
+    return part;
+}
+
+static void regex_free_part(RegexPart part) {
+    IntSet_free(part.first);
+    IntSet_free(part.last);
+}
+
+//records an error, keeping the first one
+static void regex_error(RegexParser *parser, const char *message) {
+    if (parser->error == NULL) {
+        parser->error = message;
+    }
+}
+
+//records an error and returns an empty part
+static RegexPart regex_fail(RegexParser *parser, const char *message) {
+    regex_error(parser, message);
+    return regex_empty();
+}
+
+//adds every position in from's follow set to those of the positions in to
+static void regex_link(RegexParser *parser, const IntSet *to, const IntSet *from) {
+    IntSetIterator *iterator = IntSet_iterator(to);
+    while (IntSetIterator_has_next(iterator)) {
+        IntSet_union(parser->follow[IntSetIterator_next(iterator)], from);
+    }
+    free(iterator);
+}
+
+//returns a part for a new position matching the bytes in class
+static RegexPart regex_position(RegexParser *parser, const RegexClass *class) {
+    if (parser->numOfPositions == parser->capacity) {
+        parser->capacity = parser->capacity == 0 ? 16 : 2*parser->capacity;
+        parser->classes = (RegexClass *)realloc(parser->classes, parser->capacity*sizeof(RegexClass));
+        parser->follow = (IntSet **)realloc(parser->follow, parser->capacity*sizeof(IntSet *));
+        if (parser->classes == NULL || parser->follow == NULL) {
+            abort();
+        }
+    }
+    int p = parser->numOfPositions++;
+    parser->classes[p] = *class;
+    parser->follow[p] = IntSet_new();
+    RegexPart part;
+    part.first = IntSet_new();
+    part.last = IntSet_new();
+    IntSet_add(part.first, p);
+    IntSet_add(part.last, p);
+    part.nullable = false;
+    return part;
+}
+
+//returns the part for a followed by b (freeing both)
+static RegexPart regex_concat(RegexParser *parser, RegexPart a, RegexPart b) {
+    regex_link(parser, a.last, b.first);
+    if (a.nullable) {
+        IntSet_union(a.first, b.first);
+    }
+    if (b.nullable) {
+        IntSet_union(b.last, a.last);
+    }
+    RegexPart part;
+    part.first = a.first;
+    part.last = b.last;
+    part.nullable = a.nullable && b.nullable;
+    IntSet_free(a.last);
+    IntSet_free(b.first);
+    return part;
+}
+
+//returns the part for a or b (freeing both)
+static RegexPart regex_alternate(RegexPart a, RegexPart b) {
+    IntSet_union(a.first, b.first);
+    IntSet_union(a.last, b.last);
+    a.nullable = a.nullable || b.nullable;
+    regex_free_part(b);
+    return a;
+}
+
+static void regex_class_add(RegexClass *class, int b) {
+    class->bits[b / 64] |= (uint64_t)1 << (b % 64);
+}
+
+static void regex_class_add_range(RegexClass *class, int from, int to) {
+    for (int b = from; b <= to; b++) {
+        regex_class_add(class, b);
+    }
+}
+
+static void regex_class_negate(RegexClass *class) {
+    for (int i = 0; i < 4; i++) {
+        class->bits[i] = ~class->bits[i];
+    }
+}
+
+static int regex_hex_digit(int c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+//reads the escape after a backslash; adds the bytes it stands for to
+//class and returns the byte if it is a single one, -1 for a class like \d
+static int regex_parse_escape(RegexParser *parser, RegexClass *class) {
+    unsigned char c = parser->pattern[parser->pos];
+    if (c == '\0') {
+        regex_error(parser, "pattern ends with a backslash");
+        return -1;
+    }
+    parser->pos++;
+    RegexClass named = {{0, 0, 0, 0}};
+    bool isClass = false;
+    switch (c) {
+    case 'n': c = '\n'; break;
+    case 't': c = '\t'; break;
+    case 'r': c = '\r'; break;
+    case 'f': c = '\f'; break;
+    case 'v': c = '\v'; break;
+    case 'x': {
+        int high = regex_hex_digit(parser->pattern[parser->pos]);
+        int low = high < 0 ? -1 : regex_hex_digit(parser->pattern[parser->pos + 1]);
+        if (low < 0) {
+            regex_error(parser, "\\x must be followed by two hex digits");
+            return -1;
+        }
+        parser->pos += 2;
+        c = high*16 + low;
+        break;
+    }
+    case 'd': case 'D':
+        regex_class_add_range(&named, '0', '9');
+        isClass = true;
+        break;
+    case 'w': case 'W':
+        regex_class_add_range(&named, '0', '9');
+        regex_class_add_range(&named, 'a', 'z');
+        regex_class_add_range(&named, 'A', 'Z');
+        regex_class_add(&named, '_');
+        isClass = true;
+        break;
+    case 's': case 'S':
+        regex_class_add_range(&named, '\t', '\r');
+        regex_class_add(&named, ' ');
+        isClass = true;
+        break;
+    default:
+        break;
+    }
+    if (isClass) {
+        if (c == 'D' || c == 'W' || c == 'S') {
+            regex_class_negate(&named);
+        }
+        for (int i = 0; i < 4; i++) {
+            class->bits[i] |= named.bits[i];
+        }
+        return -1;
+    }
+    regex_class_add(class, c);
+    return c;
+}
+
+//parses a bracketed class; the '[' has been read
+static RegexPart regex_parse_class(RegexParser *parser) {
+    RegexClass class = {{0, 0, 0, 0}};
+    bool negated = parser->pattern[parser->pos] == '^';
+    if (negated) {
+        parser->pos++;
+    }
+    bool firstItem = true;
+    while (parser->pattern[parser->pos] != ']' || firstItem) {
+        unsigned char c = parser->pattern[parser->pos];
+        if (c == '\0') {
+            return regex_fail(parser, "missing ] at the end of a class");
+        }
+        parser->pos++;
+        firstItem = false;
+        int from = c;
+        if (c == '\\') {
+            from = regex_parse_escape(parser, &class);
+            if (from < 0) {
+                continue;
+            }
+        } else {
+            regex_class_add(&class, c);
+        }
+        //a '-' between two bytes makes a range; elsewhere it is literal
+        const char *rest = parser->pattern + parser->pos;
+        if (rest[0] == '-' && rest[1] != ']' && rest[1] != '\0') {
+            parser->pos++;
+            int to = (unsigned char)parser->pattern[parser->pos++];
+            if (to == '\\') {
+                RegexClass ignored = {{0, 0, 0, 0}};
+                to = regex_parse_escape(parser, &ignored);
+                if (to < 0) {
+                    return regex_fail(parser, "a range must end in a single byte");
+                }
+            }
+            if (to < from) {
+                return regex_fail(parser, "range out of order in class");
+            }
+            regex_class_add_range(&class, from, to);
+        }
+    }
+    parser->pos++;
+    if (negated) {
+        regex_class_negate(&class);
+    }
+    return regex_position(parser, &class);
+}
+
+//parses a single byte, class, '.' or parenthesized group
+static RegexPart regex_parse_atom(RegexParser *parser) {
+    unsigned char c = parser->pattern[parser->pos];
+    RegexClass class = {{0, 0, 0, 0}};
+    switch (c) {
+    case '(': {
+        parser->pos++;
+        if (++parser->depth > REGEX_MAX_DEPTH) {
+            return regex_fail(parser, "groups nested too deeply");
+        }
+        RegexPart part = regex_parse_alternation(parser);
+        parser->depth--;
+        if (parser->pattern[parser->pos] != ')') {
+            regex_free_part(part);
+            return regex_fail(parser, "missing )");
+        }
+        parser->pos++;
+        return part;
+    }
+    case '[':
+        parser->pos++;
+        return regex_parse_class(parser);
+    case '.':
+        parser->pos++;
+        regex_class_negate(&class);
+        return regex_position(parser, &class);
+    case '\\':
+        parser->pos++;
+        regex_parse_escape(parser, &class);
+        return regex_position(parser, &class);
+    case '*': case '+': case '?':
+        return regex_fail(parser, "nothing to repeat");
+    case '^': case '$':
+        return regex_fail(parser, REGEX_ANCHOR_ERROR);
+    default:
+        parser->pos++;
+        regex_class_add(&class, c);
+        return regex_position(parser, &class);
+    }
+}
+
+//parses an atom followed by any number of *, + and ?
+static RegexPart regex_parse_repeat(RegexParser *parser) {
+    RegexPart part = regex_parse_atom(parser);
+    for (;;) {
+        char c = parser->pattern[parser->pos];
+        if (c == '*' || c == '+') {
+            regex_link(parser, part.last, part.first);
+        }
+        if (c == '*' || c == '?') {
+            part.nullable = true;
+        } else if (c != '+') {
+            return part;
+        }
+        parser->pos++;
+    }
+}
+
+//parses a sequence of repeats, stopping at '|', ')' or the end (or a '$'
+//ending a top-level alternative, which the caller handles)
+static RegexPart regex_parse_concatenation(RegexParser *parser) {
+    RegexPart part = regex_empty();
+    for (;;) {
+        const char *rest = parser->pattern + parser->pos;
+        bool endAnchor = rest[0] == '$' && (rest[1] == '\0' || (rest[1] == '|' && parser->depth == 0));
+        if (rest[0] == '\0' || rest[0] == '|' || rest[0] == ')' || endAnchor
+            || parser->error != NULL) {
+            return part;
+        }
+        part = regex_concat(parser, part, regex_parse_repeat(parser));
+    }
+}
+
+static RegexPart regex_parse_alternation(RegexParser *parser) {
+    RegexPart part = regex_parse_concatenation(parser);
+    while (parser->pattern[parser->pos] == '|' && parser->error == NULL) {
+        parser->pos++;
+        part = regex_alternate(part, regex_parse_concatenation(parser));
+    }
+    return part;
+}
+
+//returns a part for .* , used to leave an alternative unanchored; the
+//position is made the first time (when *position is -1) and shared by
+//every alternative after that
+static RegexPart regex_any_string(RegexParser *parser, int *position) {
+    if (*position >= 0) {
+        RegexPart part = regex_empty();
+        IntSet_add(part.first, *position);
+        IntSet_add(part.last, *position);
+        return part;
+    }
+    RegexClass any;
+    memset(&any, 0xff, sizeof(any));
+    RegexPart part = regex_position(parser, &any);
+    regex_link(parser, part.last, part.first);
+    part.nullable = true;
+    *position = parser->numOfPositions - 1;
+    return part;
+}
+
+//adds a transition from state src on every byte of the position's class
+//to each of the positions in to
+static void regex_add_edges(NFA *nfa, const RegexParser *parser, int src, const IntSet *to) {
+    IntSetIterator *iterator = IntSet_iterator(to);
+    while (IntSetIterator_has_next(iterator)) {
+        int p = IntSetIterator_next(iterator);
+        const RegexClass *class = &parser->classes[p];
+        for (int b = 0; b < 256; b++) {
+            if ((class->bits[b / 64] >> (b % 64)) & 1) {
+                NFA_add_transition(nfa, src, (char)b, p + 1);
+            }
+        }
+    }
+    free(iterator);
+}
+
+//compiles the pattern, putting .* around each top-level alternative where
+//it is not anchored if asked to; otherwise every alternative must have
+//the same anchors, and the anchor flags are set to them (when not NULL)
+static NFA* regex_compile(const char *pattern, bool unanchored, bool *startAnchor,
+                          bool *endAnchor, const char **error) {
+    RegexParser parser;
+    parser.pattern = pattern;
+    parser.pos = 0;
+    parser.error = NULL;
+    parser.depth = 0;
+    parser.numOfPositions = 0;
+    parser.capacity = 0;
+    parser.classes = NULL;
+    parser.follow = NULL;
+
+    //each top-level alternative has its own anchors, as in POSIX
+    RegexPart part;
+    bool anchoredStart = false;
+    bool anchoredEnd = false;
+    int anyBefore = -1;
+    int anyAfter = -1;
+    for (int alternative = 0; ; alternative++) {
+        bool altStart = pattern[parser.pos] == '^';
+        if (altStart) {
+            parser.pos++;
+        }
+        RegexPart alt = regex_parse_concatenation(&parser);
+        bool altEnd = parser.error == NULL && pattern[parser.pos] == '$';
+        if (altEnd) {
+            parser.pos++;
+        }
+        if (unanchored && !altStart) {
+            alt = regex_concat(&parser, regex_any_string(&parser, &anyBefore), alt);
+        }
+        if (unanchored && !altEnd) {
+            alt = regex_concat(&parser, alt, regex_any_string(&parser, &anyAfter));
+        }
+        if (alternative == 0) {
+            anchoredStart = altStart;
+            anchoredEnd = altEnd;
+            part = alt;
+        } else {
+            if (!unanchored && (altStart != anchoredStart || altEnd != anchoredEnd)) {
+                regex_error(&parser, "every alternative of a match pattern must have the same anchors");
+            }
+            part = regex_alternate(part, alt);
+        }
+        if (pattern[parser.pos] != '|' || parser.error != NULL) {
+            break;
+        }
+        parser.pos++;
+    }
+    if (parser.error == NULL && pattern[parser.pos] == ')') {
+        regex_error(&parser, "unmatched )");
+    } else if (parser.error == NULL && pattern[parser.pos] != '\0') {
+        regex_error(&parser, REGEX_ANCHOR_ERROR);
+    }
+
+    NFA *nfa = NULL;
+    if (parser.error == NULL) {
+        nfa = NFA_new(parser.numOfPositions + 1);
+        regex_add_edges(nfa, &parser, 0, part.first);
+        for (int p = 0; p < parser.numOfPositions; p++) {
+            regex_add_edges(nfa, &parser, p + 1, parser.follow[p]);
+        }
+        IntSetIterator *iterator = IntSet_iterator(part.last);
+        while (IntSetIterator_has_next(iterator)) {
+            NFA_set_accepting(nfa, IntSetIterator_next(iterator) + 1, true);
+        }
+        free(iterator);
+        if (part.nullable) {
+            NFA_set_accepting(nfa, 0, true);
+        }
+        //a Glushkov NFA suits the bit-parallel backend while it is small
+        if (parser.numOfPositions + 1 <= 64) {
+            NFA_set_backend(nfa, NFA_BACKEND_BIT_PARALLEL);
+        } else {
+            NFA_set_cache_budget(nfa, 1 << 20);
+        }
+        if (startAnchor != NULL) {
+            *startAnchor = anchoredStart;
+        }
+        if (endAnchor != NULL) {
+            *endAnchor = anchoredEnd;
+        }
+    } else if (error != NULL) {
+        *error = parser.error;
+    }
+
+    regex_free_part(part);
+    for (int p = 0; p < parser.numOfPositions; p++) {
+        IntSet_free(parser.follow[p]);
+    }
+    free(parser.follow);
+    free(parser.classes);
+    return nfa;
+}
+
+/**
+ * Compile the given pattern to a new NFA accepting the inputs it matches,
+ * or return NULL and set *error on a syntax error.
+ */
+extern NFA* regex_to_nfa(const char *pattern, const char **error) {
+    return regex_compile(pattern, true, NULL, NULL, error);
+}
+
+/**
+ * Compile the given pattern to a new NFA accepting exactly the strings it
+ * matches, and report its anchors.
+ */
+extern NFA* regex_to_match_nfa(const char *pattern, bool *anchoredStart, bool *anchoredEnd,
+                               const char **error) {
+    return regex_compile(pattern, false, anchoredStart, anchoredEnd, error);
+}
@@ -0,0 +1,53 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: regexnfa.h
+ *
+ * Compiling regular expressions to NFAs with the Glushkov (position)
+ * construction: each character or class in the pattern becomes one NFA
+ * state, entered only on the bytes it matches, so the NFA has no epsilon
+ * transitions and fits the bit-parallel backend (nfabits.c).
+ *
+ * Supported syntax:
+ *   abc       concatenation        a|b     alternation
+ *   a* a+ a?  repetition           (a)     grouping
+ *   .         any byte             [a-z_] [^0-9]  byte classes and ranges
+ *   \d \w \s  digits, word bytes, white space (\D \W \S: their complements)
+ *   \n \t \r \f \v \xHH  escaped bytes; \ before any other byte quotes it
+ *   ^ $       anchors, only at the start and end of a top-level
+ *             alternative and applying to it alone, as in POSIX: ^a|b$
+ *             matches inputs starting with a or ending with b
+ * Without ^ an alternative's match may start anywhere in the input, and
+ * without $ it may end anywhere, so an NFA for "abc" accepts every input
+ * containing abc while one for "^abc$" accepts only abc itself.
+ */
+
+#ifndef _regexnfa_h
+#define _regexnfa_h
+
+#include <stdbool.h>
+#include "nfa.h"
+
+/**
+ * Compile the given pattern to a new NFA accepting the inputs it matches.
+ * On a syntax error, return NULL and, if error is not NULL, set *error to
+ * a (static) message describing the problem.
+ */
+extern NFA* regex_to_nfa(const char *pattern, const char **error);
+
+/**
+ * Like regex_to_nfa, but without the implicit .* before and after an
+ * unanchored pattern, so the NFA accepts exactly the strings the pattern
+ * matches ("abc" accepts only abc), as searching for matches needs. Sets
+ * *anchoredStart and *anchoredEnd to whether the pattern had ^ and $. The
+ * anchors then apply to the whole match, so every top-level alternative
+ * must have the same ones (^a|^b is fine, ^a|b is a syntax error).
+ */
+extern NFA* regex_to_match_nfa(const char *pattern, bool *anchoredStart, bool *anchoredEnd,
+                               const char **error);
+
+#endif
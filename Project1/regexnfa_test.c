@@ -0,0 +1,131 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: regexnfa_test.c
+ *
+ * Test program for compiling regular expressions to NFAs: syntax errors,
+ * anchors on top-level alternatives, and the anchors reported for
+ * searching.
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include "nfa.h"
+#include "regexnfa.h"
+#include "test_util.h"
+
+//checks whether the pattern compiles, printing the error if it does not
+static void check_compiles(const char *pattern, bool expected) {
+    const char *error = NULL;
+    NFA *nfa = regex_to_nfa(pattern, &error);
+    char what[128];
+    snprintf(what, sizeof(what), "\"%s\" compiles", pattern);
+    check(what, nfa != NULL, expected);
+    if (nfa == NULL) {
+        printf("  error: %s\n", error != NULL ? error : "(none)");
+        if (error == NULL) {
+            printf("  FAILED: no error message\n");
+            test_failures++;
+        }
+    } else {
+        NFA_free(nfa);
+    }
+}
+
+//checks whether the pattern matches somewhere in the input, with both
+//NFA backends
+static void check_matches(const char *pattern, const char *input, bool expected) {
+    NFA *nfa = regex_to_nfa(pattern, NULL);
+    char what[128];
+    snprintf(what, sizeof(what), "\"%s\" matches \"%s\"", pattern, input);
+    if (nfa == NULL) {
+        printf("%s: does not compile\n  FAILED\n", what);
+        test_failures++;
+        return;
+    }
+    bool bits = NFA_run(nfa, (const unsigned char *)input, strlen(input));
+    NFA_set_backend(nfa, NFA_BACKEND_SETS);
+    bool sets = NFA_run(nfa, (const unsigned char *)input, strlen(input));
+    if (bits != sets) {
+        printf("  FAILED: the backends disagree on \"%s\"\n", input);
+        test_failures++;
+    }
+    check(what, sets, expected);
+    NFA_free(nfa);
+}
+
+//checks the anchors regex_to_match_nfa reports for the pattern
+static void check_match_anchors(const char *pattern, bool start, bool end) {
+    bool anchoredStart = false;
+    bool anchoredEnd = false;
+    NFA *nfa = regex_to_match_nfa(pattern, &anchoredStart, &anchoredEnd, NULL);
+    char what[128];
+    snprintf(what, sizeof(what), "\"%s\" anchored at the start", pattern);
+    check(what, nfa != NULL && anchoredStart, start);
+    snprintf(what, sizeof(what), "\"%s\" anchored at the end", pattern);
+    check(what, nfa != NULL && anchoredEnd, end);
+    if (nfa != NULL) {
+        NFA_free(nfa);
+    }
+}
+
+int
+main(int argc, char **argv) {
+    printf("syntax errors\n");
+    check_compiles("(ab", false);
+    check_compiles("ab)", false);
+    check_compiles("*a", false);
+    check_compiles("a|*", false);
+    check_compiles("[ab", false);
+    check_compiles("[b-a]", false);
+    check_compiles("a\\", false);
+    check_compiles("\\xZZ", false);
+    check_compiles("a^b", false);
+    check_compiles("a$b", false);
+    check_compiles("(^a)", false);
+    check_compiles("(a$|b)", false);
+    check_compiles("a**", true);
+    check_compiles("[]a]", true);
+    check_compiles("", true);
+    check_compiles("^$", true);
+    check_compiles("^a|b$", true);
+    check_compiles("(a|b)$|^c", true);
+
+    printf("anchors\n");
+    check_matches("abc", "xabcx", true);
+    check_matches("^abc$", "abc", true);
+    check_matches("^abc$", "xabc", false);
+    check_matches("a|b$", "ax", true);
+    check_matches("a|b$", "bx", false);
+    check_matches("a|b$", "xb", true);
+    check_matches("^a|b", "xb", true);
+    check_matches("^a|b", "xa", false);
+    check_matches("^a|b$", "ax", true);
+    check_matches("^a|b$", "xb", true);
+    check_matches("^a|b$", "ba", false);
+    check_matches("^a$|b", "xbx", true);
+    check_matches("^a$|b", "ax", false);
+    check_matches("x|$", "", true);
+    check_matches("^x|^$", "y", false);
+    check_matches("(a|b)$|^c", "ca", true);
+    check_matches("(a|b)$|^c", "ac", false);
+
+    printf("anchors for searching\n");
+    check_match_anchors("abc", false, false);
+    check_match_anchors("^a|^b", true, false);
+    check_match_anchors("a$|(b|c)$", false, true);
+    const char *error = NULL;
+    NFA *nfa = regex_to_match_nfa("^a|b", NULL, NULL, &error);
+    check("\"^a|b\" compiles for searching", nfa != NULL, false);
+    printf("  error: %s\n", error != NULL ? error : "(none)");
+    if (nfa != NULL) {
+        NFA_free(nfa);
+    }
+
+    return test_summary();
+}
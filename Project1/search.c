@@ -0,0 +1,340 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: search.c
+ *
+ * Both passes of a search feed a DFA_Cursor with DFA_Cursor_feed_to_accept,
+ * which stops each time the cursor accepts: once for the earliest end,
+ * and repeatedly (remembering the last stop) for the longest match. The
+ * iterator over leftmost-longest matches does the backward pass once over
+ * the whole input, marking every offset where a match starts, so finding
+ * all the matches stays linear instead of one backward pass per match.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "dfa.h"
+#include "nfa.h"
+#include "dfamin.h"
+#include "nfatodfa.h"
+#include "regexnfa.h"
+#include "search.h"
+
+struct Searcher {
+    DFA *forward;       //the matches
+    DFA *reverse;       //the matches reversed
+    DFA *forwardAny;    //any bytes and then a match, NULL with anchoredStart
+    DFA *reverseAny;    //a reversed match and then any bytes, NULL with
+                        //anchoredStart or anchoredEnd
+    bool anchoredStart;
+    bool anchoredEnd;
+};
+
+struct SearchIterator {
+    const Searcher *searcher;
+    const unsigned char *input;
+    size_t len;
+    SEARCH_KIND kind;
+    size_t from;
+    size_t lastEnd;
+    bool hasLast;
+    uint64_t *starts;   //offsets where a match starts, for leftmost-longest
+};
+
+//returns an NFA for any bytes followed by an input the given DFA accepts:
+//state 0 loops on every byte and moves to the DFA's start on epsilon, and
+//state q of the DFA becomes q + 1
+static NFA* search_any_nfa(DFA* dfa) {
+    int n = DFA_get_size(dfa);
+    NFA *nfa = NFA_new(n + 1);
+    NFA_add_transition_all(nfa, 0, 0);
+    for (int p = 0; p < n; p++) {
+        for (int b = 0; b < DFA_NUM_SYMBOLS; b++) {
+            int q = DFA_get_transition(dfa, p, (char)b);
+            if (q >= 0) {
+                NFA_add_transition(nfa, p + 1, (char)b, q + 1);
+            }
+        }
+        if (DFA_get_accepting(dfa, p)) {
+            NFA_set_accepting(nfa, p + 1, true);
+        }
+    }
+    if (n > 0) {
+        NFA_add_epsilon_transition(nfa, 0, 1);
+    }
+    return nfa;
+}
+
+//returns the finalized minimal DFA for the given NFA, freeing the NFA
+static DFA* search_dfa(NFA* nfa) {
+    DFA *dfa = nfa_to_dfa(nfa);
+    DFA *min = DFA_minimize(dfa, NULL);
+    DFA_free(dfa);
+    NFA_free(nfa);
+    DFA_finalize(min);
+    return min;
+}
+
+/**
+ * Allocate and return a new Searcher for the strings the given NFA accepts.
+ */
+extern Searcher* Searcher_new(NFA* nfa, bool anchoredStart, bool anchoredEnd) {
+    Searcher *searcher = (Searcher *)malloc(sizeof(Searcher));
+    if (searcher == NULL) {
+        abort();
+    }
+    DFA *dfa = nfa_to_dfa(nfa);
+    searcher->forward = DFA_minimize(dfa, NULL);
+    DFA_free(dfa);
+    DFA_finalize(searcher->forward);
+    searcher->reverse = DFA_reverse(searcher->forward);
+    DFA_finalize(searcher->reverse);
+    searcher->forwardAny = NULL;
+    searcher->reverseAny = NULL;
+    if (!anchoredStart) {
+        searcher->forwardAny = search_dfa(search_any_nfa(searcher->forward));
+        if (!anchoredEnd) {
+            searcher->reverseAny = search_dfa(search_any_nfa(searcher->reverse));
+        }
+    }
+    searcher->anchoredStart = anchoredStart;
+    searcher->anchoredEnd = anchoredEnd;
+    return searcher;
+}
+
+/**
+ * Allocate and return a new Searcher for the matches of the given regular
+ * expression, or return NULL and set *error on a syntax error.
+ */
+extern Searcher* Searcher_new_regex(const char *pattern, const char **error) {
+    bool anchoredStart;
+    bool anchoredEnd;
+    NFA *nfa = regex_to_match_nfa(pattern, &anchoredStart, &anchoredEnd, error);
+    if (nfa == NULL) {
+        return NULL;
+    }
+    Searcher *searcher = Searcher_new(nfa, anchoredStart, anchoredEnd);
+    NFA_free(nfa);
+    return searcher;
+}
+
+/**
+ * Free the given Searcher.
+ */
+extern void Searcher_free(Searcher* searcher) {
+    DFA_free(searcher->forward);
+    DFA_free(searcher->reverse);
+    if (searcher->forwardAny != NULL) {
+        DFA_free(searcher->forwardAny);
+    }
+    if (searcher->reverseAny != NULL) {
+        DFA_free(searcher->reverseAny);
+    }
+    free(searcher);
+}
+
+//returns how many of the len bytes at input (read from the end if
+//backwards) the given DFA reads before it first accepts, or -1 if it
+//never does
+static ptrdiff_t search_earliest(const DFA* dfa, const unsigned char *input, size_t len,
+                                 bool backwards) {
+    DFA_Cursor cursor;
+    DFA_Cursor_init(&cursor, dfa);
+    if (DFA_Cursor_is_accepting(&cursor)) {
+        return 0;
+    }
+    size_t read = DFA_Cursor_feed_to_accept(&cursor, input, len, backwards);
+    return DFA_Cursor_is_accepting(&cursor) ? (ptrdiff_t)read : -1;
+}
+
+//returns the most of the len bytes at input (read from the end if
+//backwards) after which the given DFA accepts, or -1 if it never does;
+//stops once the DFA is stuck or accepts whatever follows
+static ptrdiff_t search_longest(const DFA* dfa, const unsigned char *input, size_t len,
+                                bool backwards) {
+    DFA_Cursor cursor;
+    DFA_Cursor_init(&cursor, dfa);
+    ptrdiff_t longest = DFA_Cursor_is_accepting(&cursor) ? 0 : -1;
+    size_t read = 0;
+    while (read < len && !DFA_Cursor_is_decided(&cursor)) {
+        const unsigned char *rest = backwards ? input : input + read;
+        read += DFA_Cursor_feed_to_accept(&cursor, rest, len - read, backwards);
+        if (DFA_Cursor_is_accepting(&cursor)) {
+            longest = read;
+        }
+    }
+    if (read < len && DFA_Cursor_is_accepting(&cursor)) {
+        longest = len;
+    }
+    return longest;
+}
+
+/**
+ * Search the given input from offset from on for a match of the given
+ * kind, and set *start and *end to its offsets.
+ */
+extern bool Searcher_find(const Searcher* searcher, const unsigned char *input, size_t len,
+                          size_t from, SEARCH_KIND kind, size_t *start, size_t *end) {
+    if (from > len || (searcher->anchoredStart && from > 0)) {
+        return false;
+    }
+    ptrdiff_t n;
+    size_t s;
+    size_t e;
+    if (searcher->anchoredStart) {
+        //the match can only start at 0, so the forward DFA does it all
+        if (kind == SEARCH_EARLIEST && !searcher->anchoredEnd) {
+            n = search_earliest(searcher->forward, input, len, false);
+        } else {
+            n = search_longest(searcher->forward, input, len, false);
+        }
+        if (n < 0 || (searcher->anchoredEnd && (size_t)n != len)) {
+            return false;
+        }
+        s = 0;
+        e = n;
+    } else if (searcher->anchoredEnd) {
+        //every match ends at len, and the leftmost one is also the longest
+        n = search_longest(searcher->reverse, input + from, len - from, true);
+        if (n < 0) {
+            return false;
+        }
+        s = len - n;
+        e = len;
+    } else if (kind == SEARCH_EARLIEST) {
+        n = search_earliest(searcher->forwardAny, input + from, len - from, false);
+        if (n < 0) {
+            return false;
+        }
+        e = from + n;
+        s = e - search_longest(searcher->reverse, input + from, n, true);
+    } else {
+        n = search_longest(searcher->reverseAny, input + from, len - from, true);
+        if (n < 0) {
+            return false;
+        }
+        s = len - n;
+        e = s + search_longest(searcher->forward, input + s, len - s, false);
+    }
+    *start = s;
+    *end = e;
+    return true;
+}
+
+//marks the offsets in the iterator's input where a match starts, with one
+//backward pass of the reversed DFA that may start anywhere
+static void search_mark_starts(SearchIterator* iterator) {
+    size_t len = iterator->len;
+    uint64_t *starts = (uint64_t *)calloc(len/64 + 1, sizeof(uint64_t));
+    if (starts == NULL) {
+        abort();
+    }
+    DFA_Cursor cursor;
+    DFA_Cursor_init(&cursor, iterator->searcher->reverseAny);
+    size_t read = 0;
+    for (;;) {
+        if (DFA_Cursor_is_accepting(&cursor)) {
+            size_t pos = len - read;
+            starts[pos / 64] |= (uint64_t)1 << (pos % 64);
+            if (DFA_Cursor_is_decided(&cursor)) {
+                //a match starts at every offset left
+                for (size_t p = 0; p < pos; p++) {
+                    starts[p / 64] |= (uint64_t)1 << (p % 64);
+                }
+                break;
+            }
+        }
+        if (read == len || DFA_Cursor_is_decided(&cursor)) {
+            break;
+        }
+        read += DFA_Cursor_feed_to_accept(&cursor, iterator->input, len - read, true);
+    }
+    iterator->starts = starts;
+}
+
+//returns the first marked offset at or after from, or len + 1 if none is
+static size_t search_next_start(const SearchIterator* iterator, size_t from) {
+    size_t numOfWords = iterator->len/64 + 1;
+    size_t w = from / 64;
+    if (w >= numOfWords) {
+        return iterator->len + 1;
+    }
+    uint64_t word = iterator->starts[w] & (~(uint64_t)0 << (from % 64));
+    while (word == 0) {
+        if (++w == numOfWords) {
+            return iterator->len + 1;
+        }
+        word = iterator->starts[w];
+    }
+    return w*64 + __builtin_ctzll(word);
+}
+
+/**
+ * Return an iterator over the non-overlapping matches of the given kind.
+ */
+extern SearchIterator* Searcher_iterator(const Searcher* searcher, const unsigned char *input,
+                                         size_t len, SEARCH_KIND kind) {
+    SearchIterator *iterator = (SearchIterator *)malloc(sizeof(SearchIterator));
+    if (iterator == NULL) {
+        abort();
+    }
+    iterator->searcher = searcher;
+    iterator->input = input;
+    iterator->len = len;
+    iterator->kind = kind;
+    iterator->from = 0;
+    iterator->lastEnd = 0;
+    iterator->hasLast = false;
+    iterator->starts = NULL;
+    if (kind == SEARCH_LEFTMOST_LONGEST && searcher->reverseAny != NULL) {
+        search_mark_starts(iterator);
+    }
+    return iterator;
+}
+
+/**
+ * Find the next match and set *start and *end to its offsets.
+ */
+extern bool SearchIterator_next(SearchIterator* iterator, size_t *start, size_t *end) {
+    const Searcher *searcher = iterator->searcher;
+    while (iterator->from <= iterator->len) {
+        size_t s;
+        size_t e;
+        if (iterator->starts != NULL) {
+            s = search_next_start(iterator, iterator->from);
+            if (s > iterator->len) {
+                break;
+            }
+            e = s + search_longest(searcher->forward, iterator->input + s, iterator->len - s, false);
+        } else if (!Searcher_find(searcher, iterator->input, iterator->len, iterator->from,
+                                  iterator->kind, &s, &e)) {
+            break;
+        }
+        iterator->from = e > s ? e : s + 1;
+        if (s == e && iterator->hasLast && s == iterator->lastEnd) {
+            continue;
+        }
+        iterator->lastEnd = e;
+        iterator->hasLast = true;
+        *start = s;
+        *end = e;
+        return true;
+    }
+    iterator->from = iterator->len + 1;
+    return false;
+}
+
+/**
+ * Free the given iterator.
+ */
+extern void SearchIterator_free(SearchIterator* iterator) {
+    free(iterator->starts);
+    free(iterator);
+}
@@ -0,0 +1,99 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: search.h
+ *
+ * Finding where in an input the strings of a language occur, rather than
+ * whether the whole input is accepted. A Searcher holds four DFAs built
+ * from an automaton for the matches themselves: one for the matches, one
+ * for the matches reversed, and versions of both that may start anywhere.
+ * A search is one pass forwards and one backwards over the input:
+ *
+ *   SEARCH_EARLIEST: the match that ends first. A forward pass that may
+ *     start anywhere stops at the first end, then the reversed DFA runs
+ *     back from it to find the leftmost start of a match ending there.
+ *     Only the input up to that end is read.
+ *   SEARCH_LEFTMOST_LONGEST: the match that starts first, taking the
+ *     longest one starting there (POSIX). A backward pass of the reversed
+ *     DFA that may start anywhere finds the leftmost start, then the
+ *     forward DFA runs from it for as long as it can still match.
+ *
+ * A DFA has no notion of which alternative was written first, so there is
+ * no Perl-style "leftmost-first" kind; SEARCH_EARLIEST is the cheap one.
+ */
+
+#ifndef _search_h
+#define _search_h
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "nfa.h"
+
+typedef enum {
+    SEARCH_EARLIEST,
+    SEARCH_LEFTMOST_LONGEST
+} SEARCH_KIND;
+
+// Partial declaration
+typedef struct Searcher Searcher;
+
+/**
+ * Allocate and return a new Searcher for the strings the given NFA
+ * accepts. With anchoredStart a match must start at the beginning of the
+ * input, and with anchoredEnd it must end at its end. The NFA is not
+ * needed afterwards.
+ */
+extern Searcher* Searcher_new(NFA* nfa, bool anchoredStart, bool anchoredEnd);
+
+/**
+ * Allocate and return a new Searcher for the matches of the given regular
+ * expression (see regexnfa.h); "code" finds each occurrence of code. On a
+ * syntax error, return NULL and set *error like regex_to_nfa.
+ */
+extern Searcher* Searcher_new_regex(const char *pattern, const char **error);
+
+/**
+ * Free the given Searcher.
+ */
+extern void Searcher_free(Searcher* searcher);
+
+/**
+ * Search the len bytes at input, from offset from on, for a match of the
+ * given kind. Returns true if there is one, and then sets *start and *end
+ * to its offsets in input (the match is input[*start] to input[*end - 1];
+ * it is empty if they are equal). The anchors are relative to the whole
+ * input, not to from. Only reads the Searcher, so it can be shared by
+ * threads.
+ */
+extern bool Searcher_find(const Searcher* searcher, const unsigned char *input, size_t len,
+                          size_t from, SEARCH_KIND kind, size_t *start, size_t *end);
+
+// Partial declaration
+typedef struct SearchIterator SearchIterator;
+
+/**
+ * Return an iterator over the non-overlapping matches of the given kind
+ * in the len bytes at input, from left to right. After a match the next
+ * one is searched for from where it ended; an empty match right where the
+ * previous one ended is skipped. The input must stay valid while the
+ * iterator is used, and the iterator is freed with SearchIterator_free.
+ */
+extern SearchIterator* Searcher_iterator(const Searcher* searcher, const unsigned char *input,
+                                         size_t len, SEARCH_KIND kind);
+
+/**
+ * Find the next match, returning false when there are no more, and set
+ * *start and *end to its offsets like Searcher_find.
+ */
+extern bool SearchIterator_next(SearchIterator* iterator, size_t *start, size_t *end);
+
+/**
+ * Free the given iterator.
+ */
+extern void SearchIterator_free(SearchIterator* iterator);
+
+#endif
@@ -0,0 +1,113 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: search_test.c
+ *
+ * Test program for finding match offsets with a Searcher, with each kind
+ * of search and with anchors, and for the accepting states of NFAs that
+ * searching builds on.
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include "nfa.h"
+#include "search.h"
+#include "test_util.h"
+
+static const char *kind_name(SEARCH_KIND kind) {
+    return kind == SEARCH_EARLIEST ? "earliest" : "leftmost-longest";
+}
+
+//checks the first match of the given kind from offset from, where
+//expected is "start,end" or "none"
+static void check_find(const char *pattern, const char *input, size_t from, SEARCH_KIND kind,
+                       const char *expected) {
+    Searcher *searcher = Searcher_new_regex(pattern, NULL);
+    char got[64] = "none";
+    size_t start;
+    size_t end;
+    if (Searcher_find(searcher, (const unsigned char *)input, strlen(input), from, kind,
+                      &start, &end)) {
+        snprintf(got, sizeof(got), "%zu,%zu", start, end);
+    }
+    printf("%s match of \"%s\" in \"%s\" from %zu = %s\n", kind_name(kind), pattern, input,
+           from, got);
+    if (strcmp(got, expected) != 0) {
+        printf("  FAILED: expected %s\n", expected);
+        test_failures++;
+    }
+    Searcher_free(searcher);
+}
+
+//checks every match the iterator finds, where expected lists them like
+//"1,2 3,4" (empty if there are none)
+static void check_all(const char *pattern, const char *input, SEARCH_KIND kind,
+                      const char *expected) {
+    Searcher *searcher = Searcher_new_regex(pattern, NULL);
+    SearchIterator *iterator = Searcher_iterator(searcher, (const unsigned char *)input,
+                                                 strlen(input), kind);
+    char got[256] = "";
+    size_t start;
+    size_t end;
+    while (SearchIterator_next(iterator, &start, &end)) {
+        size_t used = strlen(got);
+        snprintf(got + used, sizeof(got) - used, "%s%zu,%zu", used > 0 ? " " : "", start, end);
+    }
+    printf("%s matches of \"%s\" in \"%s\" = %s\n", kind_name(kind), pattern, input, got);
+    if (strcmp(got, expected) != 0) {
+        printf("  FAILED: expected %s\n", expected);
+        test_failures++;
+    }
+    SearchIterator_free(iterator);
+    Searcher_free(searcher);
+}
+
+int
+main(int argc, char **argv) {
+    printf("accepting states\n");
+    NFA *nfa = NFA_new(3);
+    NFA_add_transition(nfa, 0, 'a', 1);
+    NFA_add_transition(nfa, 1, 'b', 2);
+    NFA_set_accepting(nfa, 2, true);
+    NFA_set_accepting(nfa, 2, true);
+    NFA_set_accepting(nfa, 1, false);
+    check("ab accepts ab", NFA_run(nfa, (const unsigned char *)"ab", 2), true);
+    NFA_set_accepting(nfa, 2, false);
+    NFA_set_accepting(nfa, 1, true);
+    check("a accepts ab", NFA_run(nfa, (const unsigned char *)"ab", 2), false);
+    check("a accepts a", NFA_run(nfa, (const unsigned char *)"a", 1), true);
+    NFA_free(nfa);
+
+    printf("single matches\n");
+    check_find("abc", "xxabcabc", 0, SEARCH_EARLIEST, "2,5");
+    check_find("abc", "xxabcabc", 3, SEARCH_LEFTMOST_LONGEST, "5,8");
+    check_find("abc", "xxabab", 0, SEARCH_EARLIEST, "none");
+    check_find("a+", "baaab", 0, SEARCH_EARLIEST, "1,2");
+    check_find("a+", "baaab", 0, SEARCH_LEFTMOST_LONGEST, "1,4");
+    check_find("b|abc", "abc", 0, SEARCH_EARLIEST, "1,2");
+    check_find("b|abc", "abc", 0, SEARCH_LEFTMOST_LONGEST, "0,3");
+    check_find("x*", "ab", 0, SEARCH_EARLIEST, "0,0");
+    check_find("x*", "axxb", 1, SEARCH_LEFTMOST_LONGEST, "1,3");
+    check_find("^ab", "abab", 0, SEARCH_LEFTMOST_LONGEST, "0,2");
+    check_find("^ab", "abab", 1, SEARCH_EARLIEST, "none");
+    check_find("ab$", "abab", 0, SEARCH_EARLIEST, "2,4");
+    check_find("^a|^b", "bx", 0, SEARCH_EARLIEST, "0,1");
+    check_find("^a*$", "aaa", 0, SEARCH_EARLIEST, "0,3");
+
+    printf("all matches\n");
+    check_all("abc", "xxabcabc", SEARCH_EARLIEST, "2,5 5,8");
+    check_all("abc", "xxabcabc", SEARCH_LEFTMOST_LONGEST, "2,5 5,8");
+    check_all("a+", "baaaba", SEARCH_EARLIEST, "1,2 2,3 3,4 5,6");
+    check_all("a+", "baaaba", SEARCH_LEFTMOST_LONGEST, "1,4 5,6");
+    check_all("x*", "ab", SEARCH_EARLIEST, "0,0 1,1 2,2");
+    check_all("x*", "axb", SEARCH_LEFTMOST_LONGEST, "0,0 1,2 3,3");
+    check_all("ab$", "abab", SEARCH_LEFTMOST_LONGEST, "2,4");
+    check_all("zz", "abab", SEARCH_LEFTMOST_LONGEST, "");
+
+    return test_summary();
+}
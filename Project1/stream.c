@@ -0,0 +1,68 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <unistd.h>
+#include "stream.h"
+
+//reads the next chunk into buffer, retrying if interrupted; returns the
+//number of bytes read, 0 at end of file or -1 on error
+static ssize_t read_chunk(int fd, unsigned char *buffer) {
+    ssize_t count;
+    do {
+        count = read(fd, buffer, STREAM_CHUNK_SIZE);
+    } while (count < 0 && errno == EINTR);
+    return count;
+}
+
+/**
+ * Run the given DFA over everything that can be read from the given file
+ * descriptor, one chunk at a time.
+ */
+extern int DFA_run_fd(const DFA* dfa, int fd) {
+    unsigned char buffer[STREAM_CHUNK_SIZE];
+    DFA_Cursor cursor;
+    DFA_Cursor_init(&cursor, dfa);
+    while (!DFA_Cursor_is_decided(&cursor)) {
+        ssize_t count = read_chunk(fd, buffer);
+        if (count < 0) {
+            return -1;
+        }
+        if (count == 0) {
+            break;
+        }
+        DFA_Cursor_feed(&cursor, buffer, count);
+    }
+    return DFA_Cursor_is_accepting(&cursor);
+}
+
+/**
+ * Run the given NFA over everything that can be read from the given file
+ * descriptor, one chunk at a time.
+ */
+extern int NFA_run_fd(NFA* nfa, int fd) {
+    unsigned char buffer[STREAM_CHUNK_SIZE];
+    NFA_Cursor *cursor = NFA_Cursor_new(nfa);
+    int result = 0;
+    while (!NFA_Cursor_is_decided(cursor)) {
+        ssize_t count = read_chunk(fd, buffer);
+        if (count < 0) {
+            result = -1;
+            break;
+        }
+        if (count == 0) {
+            break;
+        }
+        NFA_Cursor_feed(cursor, buffer, count);
+    }
+    if (result == 0) {
+        result = NFA_Cursor_is_accepting(cursor);
+    }
+    NFA_Cursor_free(cursor);
+    return result;
+}
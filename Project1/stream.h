@@ -0,0 +1,42 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: stream.h
+ *
+ * Running automata over files and pipes a fixed-size chunk at a time,
+ * carrying the automaton's state across chunk boundaries, so memory use
+ * does not depend on the size of the input.
+ */
+
+#ifndef _stream_h
+#define _stream_h
+
+#include "dfa.h"
+#include "nfa.h"
+
+/**
+ * The number of bytes read from the file descriptor at a time.
+ */
+#define STREAM_CHUNK_SIZE 65536
+
+/**
+ * Run the given DFA over everything that can be read from the given file
+ * descriptor (until end of file), treating it as one input.
+ * Returns 1 if the DFA accepts it, 0 if not and -1 if reading failed.
+ * Reading stops early once more input cannot change the outcome.
+ */
+extern int DFA_run_fd(const DFA* dfa, int fd);
+
+/**
+ * Run the given NFA over everything that can be read from the given file
+ * descriptor (until end of file), treating it as one input.
+ * Returns 1 if the NFA accepts it, 0 if not and -1 if reading failed.
+ * Reading stops early once more input cannot change the outcome.
+ */
+extern int NFA_run_fd(NFA* nfa, int fd);
+
+#endif
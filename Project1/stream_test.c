@@ -0,0 +1,149 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: stream_test.c
+ *
+ * Test program for running DFAs and NFAs over files with DFA_run_fd and
+ * NFA_run_fd, on inputs whose interesting bytes straddle the boundaries
+ * between the chunks that are read, with each NFA backend.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "dfa.h"
+#include "nfa.h"
+#include "nfatodfa.h"
+#include "stream.h"
+#include "test_util.h"
+
+#define INPUT_SIZE (3 * STREAM_CHUNK_SIZE)
+
+//returns a temporary file holding the len bytes at input, ready to read
+static FILE* temp_input(const unsigned char *input, size_t len) {
+    FILE *file = tmpfile();
+    if (file == NULL || fwrite(input, 1, len, file) != len || fflush(file) != 0) {
+        perror("stream_test");
+        exit(1);
+    }
+    rewind(file);
+    return file;
+}
+
+//fills the first len bytes of input with fill, and then puts the given
+//string at the given offset
+static void make_input(unsigned char *input, size_t len, char fill, const char *string,
+                       size_t offset) {
+    memset(input, fill, len);
+    memcpy(input + offset, string, strlen(string));
+}
+
+//checks DFA_run_fd on the len bytes at input against expected and DFA_run
+static void check_dfa(const char *what, DFA* dfa, const unsigned char *input, size_t len,
+                      bool expected) {
+    FILE *file = temp_input(input, len);
+    check(what, DFA_run_fd(dfa, fileno(file)), expected);
+    fclose(file);
+    if (DFA_run(dfa, input, len) != expected) {
+        printf("  FAILED: DFA_run disagrees\n");
+        test_failures++;
+    }
+}
+
+//checks NFA_run_fd on the len bytes at input against expected and NFA_run,
+//with each backend and with a cache budget of 0
+static void check_nfa(const char *what, NFA* nfa, const unsigned char *input, size_t len,
+                      bool expected) {
+    static const char *names[] = { "sets", "lazy DFA", "bit-parallel", "budget 0" };
+    for (int backend = 0; backend < 4; backend++) {
+        if (backend < 3) {
+            NFA_set_backend(nfa, (NFA_BACKEND)backend);
+        } else {
+            NFA_set_cache_budget(nfa, 0);
+        }
+        char name[128];
+        snprintf(name, sizeof(name), "%s (%s)", what, names[backend]);
+        FILE *file = temp_input(input, len);
+        check(name, NFA_run_fd(nfa, fileno(file)), expected);
+        fclose(file);
+        if (NFA_run(nfa, input, len) != expected) {
+            printf("  FAILED: NFA_run disagrees\n");
+            test_failures++;
+        }
+    }
+    NFA_set_cache_budget(nfa, 1 << 20);
+}
+
+int
+main(int argc, char **argv) {
+    unsigned char *input = (unsigned char*)malloc(INPUT_SIZE);
+    if (input == NULL) {
+        abort();
+    }
+    size_t chunk = STREAM_CHUNK_SIZE;
+
+    printf("strings with code anywhere in them\n");
+    NFA *nfa = problem_2_c_nfa();
+    DFA *dfa = nfa_to_dfa(nfa);
+    DFA_finalize(dfa);
+    for (size_t offset = chunk - 4; offset <= chunk; offset++) {
+        char what[64];
+        snprintf(what, sizeof(what), "code at %zu", offset);
+        make_input(input, INPUT_SIZE, 'x', "code", offset);
+        check_dfa(what, dfa, input, INPUT_SIZE, true);
+        check_nfa(what, nfa, input, INPUT_SIZE, true);
+    }
+    make_input(input, INPUT_SIZE, 'x', "cod", chunk - 2);
+    input[2*chunk - 1] = 'e';
+    check_dfa("cod then e a chunk later", dfa, input, INPUT_SIZE, false);
+    check_nfa("cod then e a chunk later", nfa, input, INPUT_SIZE, false);
+    check_dfa("empty input", dfa, input, 0, false);
+    check_nfa("empty input", nfa, input, 0, false);
+    DFA_free(dfa);
+    NFA_free(nfa);
+
+    printf("strings ending in man\n");
+    nfa = problem_2_a_nfa();
+    dfa = nfa_to_dfa(nfa);
+    DFA_finalize(dfa);
+    for (size_t end = chunk; end <= chunk + 3; end++) {
+        char what[64];
+        snprintf(what, sizeof(what), "man ending at %zu", end);
+        make_input(input, end, 'x', "man", end - 3);
+        check_dfa(what, dfa, input, end, true);
+        check_nfa(what, nfa, input, end, true);
+        snprintf(what, sizeof(what), "man ending at %zu, then x", end);
+        input[end] = 'x';
+        check_dfa(what, dfa, input, end + 1, false);
+        check_nfa(what, nfa, input, end + 1, false);
+    }
+    DFA_free(dfa);
+    NFA_free(nfa);
+
+    printf("binary input with an even number of 1s\n");
+    dfa = problem_1_c_dfa();
+    DFA_finalize(dfa);
+    make_input(input, INPUT_SIZE, '0', "11", chunk - 1);
+    check_dfa("11 across the first boundary", dfa, input, INPUT_SIZE, true);
+    input[2*chunk] = '1';
+    check_dfa("and a 1 after the second", dfa, input, INPUT_SIZE, false);
+    input[INPUT_SIZE - 1] = 'x';
+    check_dfa("and an x at the end", dfa, input, INPUT_SIZE, false);
+    DFA_free(dfa);
+
+    printf("beginning with ab\n");
+    dfa = problem_1_b_dfa();
+    DFA_finalize(dfa);
+    make_input(input, INPUT_SIZE, 'z', "ab", 0);
+    check_dfa("ab then chunks of z", dfa, input, INPUT_SIZE, true);
+    check_dfa("b then chunks of z", dfa, input + 1, INPUT_SIZE - 1, false);
+    DFA_free(dfa);
+
+    free(input);
+    return test_summary();
+}
@@ -0,0 +1,29 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+#include <stdio.h>
+#include "test_util.h"
+
+int test_failures = 0;
+
+/**
+ * Print the result of a check and count it if it is not the expected one.
+ */
+extern void check(const char *what, int got, int expected) {
+    printf("%s? %d\n", what, got);
+    if (got != expected) {
+        printf("  FAILED: expected %d\n", expected);
+        test_failures++;
+    }
+}
+
+/**
+ * Print the number of failed checks and return the exit status.
+ */
+extern int test_summary() {
+    printf("%d failures\n", test_failures);
+    return test_failures == 0 ? 0 : 1;
+}
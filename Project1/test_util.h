@@ -0,0 +1,35 @@
+/*
+ * CSC173 Project 1
+ * Created By Sailesh Kaveti, Ryan Racicot, Bepen Neupane
+ * Net ID: skaveti, rracico3, bneupane
+ */
+
+/*
+ * File: test_util.h
+ *
+ * Checks shared by the test programs run by make test. Each check prints
+ * its result, and the ones that do not give the expected result are
+ * counted so the program can exit with a failing status.
+ */
+
+#ifndef _test_util_h
+#define _test_util_h
+
+/**
+ * The number of failed checks so far. Tests that compare something other
+ * than a number print their own FAILED line and add one to it.
+ */
+extern int test_failures;
+
+/**
+ * Print "what? got" and count a failure if got is not expected.
+ */
+extern void check(const char *what, int got, int expected);
+
+/**
+ * Print the number of failed checks and return the program's exit
+ * status: 0 if there were none, 1 otherwise.
+ */
+extern int test_summary();
+
+#endif